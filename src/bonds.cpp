@@ -66,6 +66,60 @@ void setBondEnergyFunction(std::shared_ptr<BondData> &b, const ParticleVector &p
     }
 }
 
+template <size_t num_indices, size_t num_parameters>
+int CompiledBonds::Terms<num_indices, num_parameters>::add(const std::vector<int> &index,
+                                                           const std::array<double, num_parameters> &values) {
+    assert(index.size() == num_indices);
+    indices.emplace_back();
+    std::copy(index.begin(), index.end(), indices.back().begin());
+    for (size_t i = 0; i < num_parameters; i++) {
+        parameters[i].push_back(values[i]);
+    }
+    return static_cast<int>(indices.size()) - 1;
+}
+
+CompiledBonds::CompiledBonds(const std::vector<std::shared_ptr<BondData>> &bonds) {
+    locations.reserve(bonds.size());
+    for (auto &bond : bonds) {
+        int term = 0;
+        switch (bond->type()) {
+        case BondData::HARMONIC: {
+            const auto &b = dynamic_cast<const HarmonicBond &>(*bond);
+            term = harmonic.add(b.index, {b.k_half, b.req});
+            break;
+        }
+        case BondData::FENE: {
+            const auto &b = dynamic_cast<const FENEBond &>(*bond);
+            term = fene.add(b.index, {b.k_half, b.rmax_squared});
+            break;
+        }
+        case BondData::FENEWCA: {
+            const auto &b = dynamic_cast<const FENEWCABond &>(*bond);
+            term = fene_wca.add(b.index, {b.k_half, b.rmax_squared, b.epsilon, b.sigma_squared});
+            break;
+        }
+        case BondData::HARMONIC_TORSION: {
+            const auto &b = dynamic_cast<const HarmonicTorsion &>(*bond);
+            term = harmonic_torsion.add(b.index, {b.k_half, b.aeq});
+            break;
+        }
+        case BondData::GROMOS_TORSION: {
+            const auto &b = dynamic_cast<const GromosTorsion &>(*bond);
+            term = gromos_torsion.add(b.index, {b.k_half, b.cos_aeq});
+            break;
+        }
+        case BondData::PERIODIC_DIHEDRAL: {
+            const auto &b = dynamic_cast<const PeriodicDihedral &>(*bond);
+            term = periodic_dihedral.add(b.index, {b.k, b.phi, b.n});
+            break;
+        }
+        default:
+            throw std::runtime_error("cannot compile bond type " + bond->name());
+        }
+        locations.emplace_back(bond->type(), term);
+    }
+}
+
 void BondData::shift(int offset) {
     for (auto &i : index)
         i += offset;
@@ -95,8 +149,7 @@ BondData::Variant HarmonicBond::type() const { return BondData::HARMONIC; }
 
 void HarmonicBond::setEnergyFunction(const ParticleVector &p) {
     energy = [&](Geometry::DistanceFunction dist) {
-        double d = req - dist(p[index[0]].pos, p[index[1]].pos).norm();
-        return k_half * d * d;
+        return BondEnergy::harmonic(k_half, req, dist(p[index[0]].pos, p[index[1]].pos).norm());
     };
 }
 
@@ -120,9 +173,7 @@ std::string FENEBond::name() const { return "fene"; }
 
 void FENEBond::setEnergyFunction(const ParticleVector &p) {
     energy = [&](Geometry::DistanceFunction dist) {
-        double r_squared = dist(p[index[0]].pos, p[index[1]].pos).squaredNorm();
-        return (r_squared >= rmax_squared) ? pc::infty
-                                           : -k_half * rmax_squared * std::log(1 - r_squared / rmax_squared);
+        return BondEnergy::fene(k_half, rmax_squared, dist(p[index[0]].pos, p[index[1]].pos).squaredNorm());
     };
 }
 
@@ -150,16 +201,8 @@ void FENEWCABond::to_json(Faunus::json &j) const {
 std::string FENEWCABond::name() const { return "fene+wca"; }
 void FENEWCABond::setEnergyFunction(const ParticleVector &p) {
     energy = [&](Geometry::DistanceFunction dist) {
-        double r_squared = dist(p[index[0]].pos, p[index[1]].pos).squaredNorm();
-        double wca = 0;
-        double x = sigma_squared;
-        if (r_squared <= x * 1.2599210498948732) {
-            x = x / r_squared;
-            x = x * x * x;
-            wca = epsilon * (x * x - x + 0.25);
-        }
-        return (r_squared > rmax_squared) ? pc::infty
-                                          : -k_half * rmax_squared * std::log(1 - r_squared / rmax_squared) + wca;
+        return BondEnergy::feneWCA(k_half, rmax_squared, epsilon, sigma_squared,
+                                   dist(p[index[0]].pos, p[index[1]].pos).squaredNorm());
     };
 }
 
@@ -184,10 +227,8 @@ std::shared_ptr<BondData> HarmonicTorsion::clone() const { return std::make_shar
 
 void HarmonicTorsion::setEnergyFunction(const ParticleVector &p) {
     energy = [&](Geometry::DistanceFunction dist) {
-        Point ray1 = dist(p[index[0]].pos, p[index[1]].pos);
-        Point ray2 = dist(p[index[2]].pos, p[index[1]].pos);
-        double angle = std::acos(ray1.dot(ray2) / ray1.norm() / ray2.norm());
-        return k_half * (angle - aeq) * (angle - aeq);
+        return BondEnergy::harmonicTorsion(k_half, aeq, dist(p[index[0]].pos, p[index[1]].pos),
+                                           dist(p[index[2]].pos, p[index[1]].pos));
     };
 }
 
@@ -211,10 +252,8 @@ std::shared_ptr<BondData> GromosTorsion::clone() const { return std::make_shared
 
 void GromosTorsion::setEnergyFunction(const ParticleVector &p) {
     energy = [&](Geometry::DistanceFunction dist) {
-        Point ray1 = dist(p[index[0]].pos, p[index[1]].pos);
-        Point ray2 = dist(p[index[2]].pos, p[index[1]].pos);
-        double dcos = cos_aeq - ray1.dot(ray2) / (ray1.norm() * ray2.norm());
-        return k_half * dcos * dcos;
+        return BondEnergy::gromosTorsion(k_half, cos_aeq, dist(p[index[0]].pos, p[index[1]].pos),
+                                         dist(p[index[2]].pos, p[index[1]].pos));
     };
 }
 
@@ -241,14 +280,9 @@ std::string PeriodicDihedral::name() const { return "periodic_dihedral"; }
 
 void PeriodicDihedral::setEnergyFunction(const ParticleVector &p) {
     energy = [&](Geometry::DistanceFunction dist) {
-        Point vec1 = dist(p[index[1]].pos, p[index[0]].pos);
-        Point vec2 = dist(p[index[2]].pos, p[index[1]].pos);
-        Point vec3 = dist(p[index[3]].pos, p[index[2]].pos);
-        Point norm1 = vec1.cross(vec2);
-        Point norm2 = vec2.cross(vec3);
-        // atan2( [v1×v2]×[v2×v3]⋅[v2/|v2|], [v1×v2]⋅[v2×v3] )
-        double angle = atan2((norm1.cross(norm2)).dot(vec2) / vec2.norm(), norm1.dot(norm2));
-        return k * (1 + cos(n * angle - phi));
+        return BondEnergy::periodicDihedral(k, phi, n, dist(p[index[1]].pos, p[index[0]].pos),
+                                            dist(p[index[2]].pos, p[index[1]].pos),
+                                            dist(p[index[3]].pos, p[index[2]].pos));
     };
 }
 
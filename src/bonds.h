@@ -151,6 +151,186 @@ struct PeriodicDihedral : public BondData {
     PeriodicDihedral(double k, double phi, double n, const std::vector<int> &index);
 };
 
+/**
+ * @brief Energies (kT) of the bond types given the parameters and distance vectors
+ *
+ * Shared by the energy functions of `BondData` and by `CompiledBonds`.
+ */
+namespace BondEnergy {
+
+inline double harmonic(double k_half, double req, double r) {
+    const double d = req - r;
+    return k_half * d * d;
+}
+
+inline double fene(double k_half, double rmax_squared, double r_squared) {
+    return (r_squared >= rmax_squared) ? pc::infty : -k_half * rmax_squared * std::log(1 - r_squared / rmax_squared);
+}
+
+inline double feneWCA(double k_half, double rmax_squared, double epsilon, double sigma_squared, double r_squared) {
+    if (r_squared > rmax_squared)
+        return pc::infty;
+    double wca = 0, x = sigma_squared;
+    if (r_squared <= x * 1.2599210498948732) {
+        x = x / r_squared;
+        x = x * x * x;
+        wca = epsilon * (x * x - x + 0.25);
+    }
+    return -k_half * rmax_squared * std::log(1 - r_squared / rmax_squared) + wca;
+}
+
+inline double harmonicTorsion(double k_half, double aeq, const Point &ray1, const Point &ray2) {
+    const double d = std::acos(ray1.dot(ray2) / ray1.norm() / ray2.norm()) - aeq;
+    return k_half * d * d;
+}
+
+inline double gromosTorsion(double k_half, double cos_aeq, const Point &ray1, const Point &ray2) {
+    const double dcos = cos_aeq - ray1.dot(ray2) / (ray1.norm() * ray2.norm());
+    return k_half * dcos * dcos;
+}
+
+inline double periodicDihedral(double k, double phi, double n, const Point &vec1, const Point &vec2,
+                               const Point &vec3) {
+    const Point norm1 = vec1.cross(vec2);
+    const Point norm2 = vec2.cross(vec3);
+    // atan2( [v1×v2]×[v2×v3]⋅[v2/|v2|], [v1×v2]⋅[v2×v3] )
+    const double angle = std::atan2((norm1.cross(norm2)).dot(vec2) / vec2.norm(), norm1.dot(norm2));
+    return k * (1 + std::cos(n * angle - phi));
+}
+
+} // namespace BondEnergy
+
+/**
+ * @brief Bonded terms compiled into typed, contiguous arrays
+ *
+ * `BondData` evaluates each bond through a type-erased energy function that in turn calls a type-erased
+ * distance function. Here, the bonds are instead grouped by type into structures of arrays holding the
+ * particle indices and parameters of each term, which are evaluated in tight loops. The distance function
+ * is a template parameter so that, e.g., `Geometry::Chameleon::vdist()` can be inlined. Bonds are referred
+ * to by their position in the vector they were compiled from. The energies equal those of `BondData`.
+ */
+class CompiledBonds {
+    template <size_t num_indices, size_t num_parameters> struct Terms {
+        std::vector<std::array<int, num_indices>> indices;          //!< Particle indices of each term
+        std::array<std::vector<double>, num_parameters> parameters; //!< One array per parameter
+        size_t size() const { return indices.size(); }
+        int add(const std::vector<int> &index, const std::array<double, num_parameters> &values);
+    };
+    Terms<2, 2> harmonic;          //!< k/2, r_eq
+    Terms<2, 2> fene;              //!< k/2, r_max²
+    Terms<2, 4> fene_wca;          //!< k/2, r_max², ε, σ²
+    Terms<3, 2> harmonic_torsion;  //!< k/2, a_eq
+    Terms<3, 2> gromos_torsion;    //!< k/2, cos(a_eq)
+    Terms<4, 3> periodic_dihedral; //!< k, φ, n
+    std::vector<std::pair<BondData::Variant, int>> locations; //!< Type and term of each compiled bond
+
+    template <typename Tdistance>
+    double harmonicEnergy(size_t term, const ParticleVector &p, Tdistance &distance) const {
+        const auto &index = harmonic.indices[term];
+        return BondEnergy::harmonic(harmonic.parameters[0][term], harmonic.parameters[1][term],
+                                    distance(p[index[0]].pos, p[index[1]].pos).norm());
+    }
+
+    template <typename Tdistance>
+    double feneEnergy(size_t term, const ParticleVector &p, Tdistance &distance) const {
+        const auto &index = fene.indices[term];
+        return BondEnergy::fene(fene.parameters[0][term], fene.parameters[1][term],
+                                distance(p[index[0]].pos, p[index[1]].pos).squaredNorm());
+    }
+
+    template <typename Tdistance>
+    double feneWCAEnergy(size_t term, const ParticleVector &p, Tdistance &distance) const {
+        const auto &index = fene_wca.indices[term];
+        return BondEnergy::feneWCA(fene_wca.parameters[0][term], fene_wca.parameters[1][term],
+                                   fene_wca.parameters[2][term], fene_wca.parameters[3][term],
+                                   distance(p[index[0]].pos, p[index[1]].pos).squaredNorm());
+    }
+
+    template <typename Tdistance>
+    double harmonicTorsionEnergy(size_t term, const ParticleVector &p, Tdistance &distance) const {
+        const auto &index = harmonic_torsion.indices[term];
+        return BondEnergy::harmonicTorsion(harmonic_torsion.parameters[0][term], harmonic_torsion.parameters[1][term],
+                                           distance(p[index[0]].pos, p[index[1]].pos),
+                                           distance(p[index[2]].pos, p[index[1]].pos));
+    }
+
+    template <typename Tdistance>
+    double gromosTorsionEnergy(size_t term, const ParticleVector &p, Tdistance &distance) const {
+        const auto &index = gromos_torsion.indices[term];
+        return BondEnergy::gromosTorsion(gromos_torsion.parameters[0][term], gromos_torsion.parameters[1][term],
+                                         distance(p[index[0]].pos, p[index[1]].pos),
+                                         distance(p[index[2]].pos, p[index[1]].pos));
+    }
+
+    template <typename Tdistance>
+    double periodicDihedralEnergy(size_t term, const ParticleVector &p, Tdistance &distance) const {
+        const auto &index = periodic_dihedral.indices[term];
+        return BondEnergy::periodicDihedral(
+            periodic_dihedral.parameters[0][term], periodic_dihedral.parameters[1][term],
+            periodic_dihedral.parameters[2][term], distance(p[index[1]].pos, p[index[0]].pos),
+            distance(p[index[2]].pos, p[index[1]].pos), distance(p[index[3]].pos, p[index[2]].pos));
+    }
+
+  public:
+    CompiledBonds() = default;
+    explicit CompiledBonds(const std::vector<std::shared_ptr<BondData>> &bonds); //!< Compile bonds; indices as is
+    size_t size() const { return locations.size(); } //!< Number of compiled bonds
+
+    /**
+     * @brief Total energy of all bonds (kT)
+     * @param particles Particles referred to by the bond indices
+     * @param distance Function returning the distance vector between two positions
+     */
+    template <typename Tdistance> double energy(const ParticleVector &particles, Tdistance distance) const {
+        double u = 0;
+        for (size_t term = 0; term < harmonic.size(); term++) {
+            u += harmonicEnergy(term, particles, distance);
+        }
+        for (size_t term = 0; term < fene.size(); term++) {
+            u += feneEnergy(term, particles, distance);
+        }
+        for (size_t term = 0; term < fene_wca.size(); term++) {
+            u += feneWCAEnergy(term, particles, distance);
+        }
+        for (size_t term = 0; term < harmonic_torsion.size(); term++) {
+            u += harmonicTorsionEnergy(term, particles, distance);
+        }
+        for (size_t term = 0; term < gromos_torsion.size(); term++) {
+            u += gromosTorsionEnergy(term, particles, distance);
+        }
+        for (size_t term = 0; term < periodic_dihedral.size(); term++) {
+            u += periodicDihedralEnergy(term, particles, distance);
+        }
+        return u;
+    }
+
+    /**
+     * @brief Energy of a single bond (kT)
+     * @param bond Position of the bond in the vector it was compiled from
+     */
+    template <typename Tdistance>
+    double energy(int bond, const ParticleVector &particles, Tdistance distance) const {
+        const auto [type, term] = locations[bond];
+        switch (type) {
+        case BondData::HARMONIC:
+            return harmonicEnergy(term, particles, distance);
+        case BondData::FENE:
+            return feneEnergy(term, particles, distance);
+        case BondData::FENEWCA:
+            return feneWCAEnergy(term, particles, distance);
+        case BondData::HARMONIC_TORSION:
+            return harmonicTorsionEnergy(term, particles, distance);
+        case BondData::GROMOS_TORSION:
+            return gromosTorsionEnergy(term, particles, distance);
+        case BondData::PERIODIC_DIHEDRAL:
+            return periodicDihedralEnergy(term, particles, distance);
+        default:
+            assert(false); // rejected upon compilation
+            return 0.0;
+        }
+    }
+};
+
 /*
  * Serialize to/from json
  */
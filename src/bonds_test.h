@@ -178,6 +178,27 @@ TEST_CASE("[Faunus] BondData") {
         }
     }
 
+    SUBCASE("CompiledBonds") {
+        ParticleVector particles(p_60deg_4a);
+        particles.emplace_back().pos = {3.0, 4.0, -2.0}; // fourth particle for the dihedral
+        std::vector<BondDataPtr> bonds = {std::make_shared<HarmonicBond>(100.0, 5.0, std::vector<int>{0, 1}),
+                                          std::make_shared<FENEBond>(100.0, 5.0, std::vector<int>{1, 2}),
+                                          std::make_shared<FENEWCABond>(1.0, 5.0, 1.0, 3.9, std::vector<int>{0, 2}),
+                                          std::make_shared<HarmonicTorsion>(1.0, 1.0, std::vector<int>{0, 1, 2}),
+                                          std::make_shared<GromosTorsion>(1.0, 0.5, std::vector<int>{0, 1, 2}),
+                                          std::make_shared<PeriodicDihedral>(10.0, 0.5, 3, std::vector<int>{0, 1, 2, 3})};
+        CompiledBonds compiled(bonds);
+        CHECK(compiled.size() == bonds.size());
+        double total_energy = 0;
+        for (size_t i = 0; i < bonds.size(); i++) {
+            setBondEnergyFunction(bonds[i], particles);
+            total_energy += bonds[i]->energy(distance);
+            CHECK(compiled.energy(i, particles, distance) == Approx(bonds[i]->energy(distance)));
+        }
+        CHECK(bonds.back()->energy(distance) > 0.0); // the dihedral contributes
+        CHECK(compiled.energy(particles, distance) == Approx(total_energy));
+    }
+
     SUBCASE("Find") {
         BasePointerVector<BondData> bonds;
         bonds.emplace_back<FENEBond>(1.0, 2.1, std::vector<int>{2, 3});
@@ -2,7 +2,9 @@
 
 #include <iostream>
 #include <vector>
-#include <set>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
 #include <cassert>
 #include <cmath>
 #include <array>
@@ -19,17 +21,17 @@ namespace Faunus {
  *
  * - cartesian space is assumed to use all 8 octants (i.e. +/i round 0,0,0)
  * - grid space use only the first octant (all +)
- * - resolution and size is set by `resize`
+ * - resolution and size is set by `resize`; the box is divided into an
+ *   integer number of cells along each dimension so that the cell side
+ *   lengths are no smaller than the requested cutoff
  * - index of neighbors to a grid point
  *   is obtained with `neighbors()`
  * - index can be moved from one grid point to another with `move()`
  * - the list of particle index in each grid point is stored in a
- *   `std::set<int>` container.
+ *   `std::vector` in a dense, row-major cell storage.
  *
  * @todo
- * - Update cell list based on Change object
  * - Make a non-periodic version
- * - std::set --> set::vector?
  *
  * @date Malmo, March 2018
  */
@@ -37,60 +39,61 @@ template <typename CellPoint = Eigen::Vector3i> class CellList {
     typedef size_t Tindex;
     typedef Eigen::Vector3d Point;
     Point halfbox;
-    double cellsize = 0;                                           // cell side length (angstrom)
-    std::vector<std::vector<std::vector<std::set<Tindex>>>> cells; // dense storage
+    Point cellsize = {0, 0, 0};                 // cell side lengths (angstrom)
+    std::vector<std::vector<Tindex>> cells;    // dense storage
 
-    std::vector<std::set<Tindex>> cells_dense;    // dense storage (to replace `cells`)
-    std::map<int, std::set<Tindex>> cells_sparse; // sparse storage
-
-    inline std::set<Tindex> &row_major(const CellPoint &c) {
-        return cells_dense[c[0] * KLM[0] * KLM[2] + c[1] * KLM[2] + c[2]]; // to replace operator[] below
-    }                                                                      // row-major ordering of dense storage
+    inline size_t row_major(const CellPoint &c) const {
+        return (c[0] * (KLM[1] + 1) + c[1]) * (KLM[2] + 1) + c[2];
+    } // row-major ordering of dense storage
 
   public:
-    bool sparse = false;
     CellPoint KLM = {0, 0, 0}; // max cell index K,L,M
 
-    std::set<Tindex> &operator[](const CellPoint &c) {
-        return cells[c[0]][c[1]][c[2]];
-    } //!< returns set with all index in given cell (complexity: constant)
+    std::vector<Tindex> &operator[](const CellPoint &c) {
+        return cells[row_major(c)];
+    } //!< returns vector with all index in given cell (complexity: constant)
+
+    const std::vector<Tindex> &operator[](const CellPoint &c) const { return cells[row_major(c)]; }
 
     CellPoint p2c(const Point &p) const {
-        return ((p + halfbox) / cellsize).array().round().template cast<int>();
+        CellPoint c = ((p + halfbox).array() / cellsize.array()).floor().template cast<int>();
+        return c.cwiseMax(0).cwiseMin(KLM); // points exactly on the box boundary go to the outermost cell
     } //!< cartesian point --> cell point
 
     Point c2p(const CellPoint &c) const {
-        return (c.template cast<double>()) * cellsize - halfbox;
-    } //!< cell point --> cartesian point
+        return (c.template cast<double>()).cwiseProduct(cellsize) - halfbox;
+    } //!< cell point --> cartesian point (lower cell corner)
+
+    void insert(Tindex i, const CellPoint &c) { (*this)[c].push_back(i); } //!< add index i to cell
+
+    void erase(Tindex i, const CellPoint &c) {
+        auto &cell = (*this)[c];
+        auto it = std::find(cell.begin(), cell.end(), i);
+        assert(it != cell.end() && "i not present in cell");
+        *it = cell.back();
+        cell.pop_back();
+    } //!< remove index i from cell (complexity: N in cell)
 
     void move(Tindex i, const CellPoint &src, const CellPoint &dst) {
-        assert((*this)[src].count(i) == 1 && "i not present in old cell");
-        assert((*this)[dst].count(i) == 0 && "i already in new cell");
-        (*this)[src].erase(i);
-        (*this)[dst].insert(i);
-    } //!< move particle index i from one cell to another (complexity: log N)
+        assert(std::count((*this)[dst].begin(), (*this)[dst].end(), i) == 0 && "i already in new cell");
+        erase(i, src);
+        insert(i, dst);
+    } //!< move particle index i from one cell to another (complexity: N in cell)
 
     void resize(const Point &box, double cutoff) {
-        clear();
-        halfbox = 0.5 * box;
-        cellsize = cutoff;
-        KLM = (box / cellsize).array().round().template cast<int>();
-        if (KLM.minCoeff() >= 3) {
-            cells.resize(KLM[0] + 1);
-            for (auto &k : cells) {
-                k.resize(KLM[1] + 1);
-                for (auto &l : k)
-                    l.resize(KLM[2] + 1);
-            }
-        } else
+        CellPoint number_of_cells = (box / cutoff).array().floor().template cast<int>();
+        if (number_of_cells.minCoeff() < 3)
             throw std::runtime_error("celllist error: too few grid point - cutoff or box too small");
+        halfbox = 0.5 * box;
+        cellsize = box.array() / number_of_cells.template cast<double>().array();
+        KLM = number_of_cells.array() - 1;
+        cells.resize(number_of_cells.prod());
+        clear();
     }
 
     void clear() {
-        for (auto &k : cells)
-            for (auto &l : k)
-                for (auto &m : l)
-                    m.clear();
+        for (auto &cell : cells)
+            cell.clear();
     } //<! clear all index in cell list
 
     template <class Tpvec, class T = std::function<Point(const typename Tpvec::value_type &)>>
@@ -98,36 +101,45 @@ template <typename CellPoint = Eigen::Vector3i> class CellList {
         const Tpvec &p, T getpos = [](auto &i) { return i; }) {
         clear();
         for (Tindex i = 0; i < p.size(); i++)
-            (*this)[p2c(getpos(p[i]))].insert(i);
+            insert(i, p2c(getpos(p[i])));
     }
 
-    void neighbors(const Eigen::Vector3i &c, std::vector<Tindex> &index, bool clear = true) const {
+    void neighbors(const CellPoint &c, std::vector<Tindex> &index, bool clear = true) const {
         if (clear)
             index.clear();
+        forEachNeighbor(c, [&](const std::vector<Tindex> &cell) { index.insert(index.end(), cell.begin(), cell.end()); });
+    } //!< Index from all 26+1 neighboring+own cells (complexity: N neighbors)
+
+    /**
+     * @brief Calls `f(cell)` for each of the 26+1 neighboring+own cells
+     *
+     * Neighbors are wrapped across the periodic boundaries. As there are at least
+     * three cells in each dimension, all 27 cells are distinct.
+     */
+    template <class Tfunction> void forEachNeighbor(const CellPoint &c, Tfunction f) const {
         int cnt = 0;
         std::array<int, 3> k = {{c[0] - 1, c[0], c[0] + 1}}, l = {{c[1] - 1, c[1], c[1] + 1}},
                            m = {{c[2] - 1, c[2], c[2] + 1}};
         if (k[0] < 0)
             k[0] = KLM[0];
-        else if (k[2] > KLM[0])
+        if (k[2] > KLM[0])
             k[2] = 0;
         if (l[0] < 0)
             l[0] = KLM[1];
-        else if (l[2] > KLM[1])
+        if (l[2] > KLM[1])
             l[2] = 0;
         if (m[0] < 0)
             m[0] = KLM[2];
-        else if (m[2] > KLM[2])
+        if (m[2] > KLM[2])
             m[2] = 0;
         for (int _k : k)
             for (int _l : l)
                 for (int _m : m) {
                     cnt++;
-                    auto &s = cells[_k][_l][_m];
-                    std::copy(s.begin(), s.end(), std::back_inserter(index));
+                    f(cells[row_major(CellPoint(_k, _l, _m))]);
                 }
         assert(cnt == 27);
-    } //!< Index from all 26+1 neighboring+own cells (complexity: N neighbors)
+    }
 };
 
 #ifdef DOCTEST_LIBRARY_INCLUDED
@@ -136,26 +148,36 @@ TEST_CASE("[Faunus] CellList") {
     Point box = {10, 20, 6};
     CellList<Eigen::Vector3i> l;
     l.resize(box, 2);
-    CHECK(l.KLM == Eigen::Vector3i(5, 10, 3));
+    CHECK(l.KLM == Eigen::Vector3i(4, 9, 2));
     CHECK(l.p2c({5, 10, 3}) == l.KLM);
     CHECK(l.p2c({-5, -10, -3}) == Eigen::Vector3i(0, 0, 0));
-    CHECK(l.p2c({0, 0, 0}) == Eigen::Vector3i(3, 5, 2));
+    CHECK(l.p2c({0, 0, 0}) == Eigen::Vector3i(2, 5, 1));
+    CHECK(l.p2c({-4.9, 9.9, 0}) == Eigen::Vector3i(0, 9, 1));
 
     std::vector<size_t> index; // index of neighbors (and self) in...
     std::vector<Point> vec;    // ...array of points
 
-    vec = {{0, 0, 0}, {0, 3, 0}};
+    vec = {{0, 0, 0}, {0, 5, 0}};
     l.update(vec);
     l.neighbors(l.p2c(vec[0]), index);
     CHECK(index.size() == 1);  // alone by myself...
     CHECK(index.front() == 0); // ...am I really me?
 
-    vec = {{0, 0, 0}, {0, -3, 0}};
+    vec = {{0, 0, 0}, {0, -1.5, 0}};
     l.update(vec);
     l.neighbors(l.p2c(vec[0]), index);
     CHECK(index.size() == 2); // now we're two
     l.neighbors(l.p2c(vec[1]), index);
     CHECK(index.size() == 2); // now we're two
+
+    vec = {{-4.9, 0, 0}, {4.9, 0, 0}}; // neighbors across the periodic boundary
+    l.update(vec);
+    l.neighbors(l.p2c(vec[0]), index);
+    CHECK(index.size() == 2);
+
+    l.move(1, l.p2c(vec[1]), l.p2c({0, 0, 0})); // ...until one of us moves away
+    l.neighbors(l.p2c(vec[0]), index);
+    CHECK(index.size() == 1);
 }
 #endif
 } // namespace Faunus
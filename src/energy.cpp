@@ -2,6 +2,8 @@
 #include "penalty.h"
 #include "potentials.h"
 #include "externalpotential.h"
+#include <unsupported/Eigen/FFT>
+#include <chrono>
 
 namespace Faunus {
 namespace Energy {
@@ -32,6 +34,52 @@ EwaldData::EwaldData(const json &j) {
         if (policy == EwaldData::INVALID)
             throw std::runtime_error("invalid `ewaldpolicy`");
     }
+    if (policy == EwaldData::PME) {
+        spline_order = j.value("spline_order", 6);
+        if (spline_order < 2)
+            throw std::runtime_error("PME `spline_order` must be at least 2");
+        if (auto it = j.find("mesh"); it == j.end()) {
+            mesh_size.setConstant(4 * int(std::ceil(n_cutoff))); // resolves the k-vectors well beyond Nyquist
+        } else if (it->is_array()) {
+            mesh_size = Eigen::Vector3i(it->at(0).get<int>(), it->at(1).get<int>(), it->at(2).get<int>());
+        } else {
+            mesh_size.setConstant(it->get<int>());
+        }
+    }
+    if (j.count("autotune") == 1)
+        autotune = j["autotune"];
+}
+
+void EwaldData::sync(const EwaldData &other, const Change &change, const Space::Tgvec &groups) {
+    if (change.dV || box_length != other.box_length) { // new k-vectors; the remaining settings are unaffected by moves
+        box_length = other.box_length;
+        check_k2_zero = other.check_k2_zero;
+        num_kvectors = other.num_kvectors;
+        k_vectors = other.k_vectors;
+        k_integers = other.k_integers;
+        mesh_indices = other.mesh_indices;
+        Aks = other.Aks;
+    }
+    Q_ion = other.Q_ion;
+    if (phase_factors.size() == 0 && other.phase_factors.size() == 0) {
+        return; // no cached phase factors
+    }
+    if (change.all || change.dV || phase_factors.cols() != other.phase_factors.cols() || groups.empty()) {
+        phase_factors = other.phase_factors;
+        return;
+    }
+    for (auto &changed_group : change.groups) {
+        auto &group = groups.at(changed_group.index);
+        const auto offset = std::distance(groups.front().begin(), group.begin());
+        if (changed_group.all || changed_group.atoms.empty()) {
+            const auto capacity = group.capacity();
+            phase_factors.middleCols(offset, capacity) = other.phase_factors.middleCols(offset, capacity);
+        } else {
+            for (auto i : changed_group.atoms) {
+                phase_factors.col(offset + i) = other.phase_factors.col(offset + i);
+            }
+        }
+    }
 }
 
 void to_json(json &j, const EwaldData &d) {
@@ -44,6 +92,12 @@ void to_json(json &j, const EwaldData &d) {
          {"spherical_sum", d.use_spherical_sum},
          {"kappa", d.kappa},
          {"ewaldscheme", d.policy}};
+    if (d.policy == EwaldData::PME) {
+        j["mesh"] = {d.mesh_size.x(), d.mesh_size.y(), d.mesh_size.z()};
+        j["spline_order"] = d.spline_order;
+    }
+    if (!d.autotune.is_null())
+        j["autotune"] = d.autotune;
 }
 
 //----------------- Ewald Policies -------------------
@@ -58,26 +112,64 @@ std::shared_ptr<EwaldPolicyBase> EwaldPolicyBase::makePolicy(EwaldData::Policies
         return std::make_shared<PolicyIonIonIPBC>();
     case EwaldData::IPBCEigen:
         return std::make_shared<PolicyIonIonIPBCEigen>();
+    case EwaldData::PME:
+        return std::make_shared<PolicyIonIonPME>();
     case EwaldData::INVALID:
         throw std::runtime_error("invalid Ewald policy");
     }
     return nullptr;
 }
 
+bool EwaldPolicyBase::parallelOverKvectors(Eigen::Index num_kvectors, size_t num_particles) {
+    constexpr size_t min_evaluations = 4096; // rough break-even of the threading overhead
+    return size_t(num_kvectors) * num_particles >= min_evaluations;
+}
+
+size_t EwaldPolicyBase::countParticles(const Space::Tgvec &groups) {
+    size_t num_particles = 0;
+    for (auto &group : groups) {
+        num_particles += group.size();
+    }
+    return num_particles;
+}
+
+size_t EwaldPolicyBase::countParticles(const Change &change) {
+    size_t num_particles = 0;
+    for (auto &changed_group : change.groups) {
+        num_particles += changed_group.atoms.size();
+    }
+    return num_particles;
+}
+
+/**
+ * Splits k-vectors into blocks for the Eigen policies so that each thread evaluates a matrix of moderate size.
+ *
+ * @param num_kvectors  number of k-vectors
+ * @param num_particles  number of particles, i.e., rows of the matrix
+ * @return number of k-vectors in a block
+ */
+static Eigen::Index kvectorBlockSize(Eigen::Index num_kvectors, Eigen::Index num_particles) {
+    constexpr Eigen::Index max_block_elements = 32768; // N × K elements of a block (256 kB)
+    return std::clamp(max_block_elements / std::max(num_particles, Eigen::Index(1)), Eigen::Index(1),
+                      std::max(num_kvectors, Eigen::Index(1)));
+}
+
 PolicyIonIon::PolicyIonIon() { cite = "doi:10.1063/1.481216"; }
 PolicyIonIonIPBC::PolicyIonIonIPBC() { cite = "doi:10/css8"; }
+PolicyIonIonPME::PolicyIonIonPME() { cite = "doi:10.1063/1.470117"; }
 
 /**
  * Resize k-vectors according to current variables and box length
  */
 void PolicyIonIon::updateBox(EwaldData &d, const Point &box) const {
-    assert(d.policy == EwaldData::PBC or d.policy == EwaldData::PBCEigen);
+    assert(d.policy == EwaldData::PBC or d.policy == EwaldData::PBCEigen or d.policy == EwaldData::PME);
     d.box_length = box;
     int n_cutoff_ceil = ceil(d.n_cutoff);
     d.check_k2_zero = 0.1 * std::pow(2 * pc::pi / d.box_length.maxCoeff(), 2);
     int k_vector_size = (2 * n_cutoff_ceil + 1) * (2 * n_cutoff_ceil + 1) * (2 * n_cutoff_ceil + 1) - 1;
     if (k_vector_size == 0) {
         d.k_vectors.resize(3, 1);
+        d.k_integers.setZero(3, 1);
         d.Aks.resize(1);
         d.k_vectors.col(0) = Point(1, 0, 0); // Just so it is not the zero-vector
         d.Aks[0] = 0;
@@ -87,6 +179,7 @@ void PolicyIonIon::updateBox(EwaldData &d, const Point &box) const {
     } else {
         double nc2 = d.n_cutoff * d.n_cutoff;
         d.k_vectors.resize(3, k_vector_size);
+        d.k_integers.resize(3, k_vector_size);
         d.Aks.resize(k_vector_size);
         d.num_kvectors = 0;
         d.k_vectors.setZero();
@@ -94,11 +187,13 @@ void PolicyIonIon::updateBox(EwaldData &d, const Point &box) const {
         int start_value = 1;
         for (int nx = 0; nx <= n_cutoff_ceil; nx++) {
             double dnx2 = double(nx * nx);
-            double factor = (nx > 0) ? 2.0 : 1.0; // optimization of PBC Ewald (and
-                                                  // always the case for IPBC Ewald)
             for (int ny = -n_cutoff_ceil * start_value; ny <= n_cutoff_ceil; ny++) {
                 double dny2 = double(ny * ny);
                 for (int nz = -n_cutoff_ceil * start_value; nz <= n_cutoff_ceil; nz++) {
+                    // |Q(-k)| = |Q(k)|, hence only one half-space is summed, where the plane nx = 0 is halved as well
+                    if (nx == 0 && (ny < 0 || (ny == 0 && nz < 0)))
+                        continue;
+                    const double factor = (nx == 0 && ny == 0 && nz == 0) ? 1.0 : 2.0; // k = 0 only for Yukawa
                     Point kv = 2 * pc::pi * Point(nx, ny, nz).cwiseQuotient(d.box_length);
                     double k2 = kv.squaredNorm() + d.kappa_squared; // last term is only for Yukawa-Ewald
                     if (k2 < d.check_k2_zero)                       // Check if k2 != 0
@@ -109,6 +204,7 @@ void PolicyIonIon::updateBox(EwaldData &d, const Point &box) const {
                             continue;
                     }
                     d.k_vectors.col(d.num_kvectors) = kv;
+                    d.k_integers.col(d.num_kvectors) = Eigen::Vector3i(nx, ny, nz);
                     d.Aks[d.num_kvectors] = factor * exp(-k2 / (4 * d.alpha * d.alpha)) / k2;
                     d.num_kvectors++;
                 }
@@ -118,55 +214,230 @@ void PolicyIonIon::updateBox(EwaldData &d, const Point &box) const {
         d.Q_dipole.resize(d.num_kvectors);
         d.Aks.conservativeResize(d.num_kvectors);
         d.k_vectors.conservativeResize(3, d.num_kvectors);
+        d.k_integers.conservativeResize(3, d.num_kvectors);
     }
 }
 
 /**
- * @todo Add OpenMP pragma to first loop
+ * @brief exp(i k.r) of a k-vector from the per-axis phase factors of a particle
+ *
+ * Only non-negative integers are tabulated, as exp(-i θ) is the complex conjugate of exp(i θ).
+ *
+ * @param factors  phase factors exp(i 2π n r / L) for n = 0..n_max along each axis
+ * @param n  integer components of the k-vector
  */
-void PolicyIonIon::updateComplex(EwaldData &data, Space::Tgvec &groups) const {
-    for (int k = 0; k < data.k_vectors.cols(); k++) {
-        const Point &q = data.k_vectors.col(k);
-        EwaldData::Tcomplex Q(0, 0);
-        for (auto &g : groups) {       // loop over molecules
-            for (auto &particle : g) { // loop over active particles
-                double qr = q.dot(particle.pos);
-                Q += particle.charge * EwaldData::Tcomplex(std::cos(qr),
-                                                           std::sin(qr)); // 'Q^q', see eq. 25 in ref.
-            }
-            data.Q_ion[k] = Q;
+template <typename TFactors, typename TIntegers>
+static EwaldData::Tcomplex phaseFromFactors(const TFactors &factors, const TIntegers &n) {
+    const Eigen::Index num_per_axis = factors.size() / 3;
+    EwaldData::Tcomplex phase(1.0, 0.0);
+    for (int dim = 0; dim < 3; dim++) {
+        const EwaldData::Tcomplex &factor = factors[dim * num_per_axis + std::abs(n[dim])];
+        phase *= (n[dim] < 0) ? std::conj(factor) : factor;
+    }
+    return phase;
+}
+
+/**
+ * @brief Product of cosines, cos(k_x x) cos(k_y y) cos(k_z z), from the per-axis phase factors of a particle
+ * @see phaseFromFactors
+ */
+template <typename TFactors, typename TIntegers>
+static EwaldData::Tcomplex cosineProductFromFactors(const TFactors &factors, const TIntegers &n) {
+    const Eigen::Index num_per_axis = factors.size() / 3;
+    double product = 1.0;
+    for (int dim = 0; dim < 3; dim++) {
+        product *= factors[dim * num_per_axis + std::abs(n[dim])].real(); // see eq. 2 in doi:10/css8
+    }
+    return product;
+}
+
+/**
+ * A single sine and cosine per axis suffice, as the factors follow from the recursion
+ * exp(i (n + 1) θ) = exp(i n θ) exp(i θ).
+ */
+void PolicyIonIon::setPhaseFactors(EwaldData &d, const Point &position, Eigen::Index particle_index) {
+    const Eigen::Index num_per_axis = d.phase_factors.rows() / 3;
+    auto factors = d.phase_factors.col(particle_index);
+    for (int dim = 0; dim < 3; dim++) {
+        const EwaldData::Tcomplex unit_factor = std::polar(1.0, 2 * pc::pi * position[dim] / d.box_length[dim]);
+        const Eigen::Index first = dim * num_per_axis;
+        factors[first] = 1.0;
+        for (Eigen::Index n = 1; n < num_per_axis; n++) {
+            factors[first + n] = factors[first + n - 1] * unit_factor;
         }
     }
 }
 
-void PolicyIonIonEigen::updateComplex(EwaldData &data, Space::Tgvec &groups) const {
-    auto [pos, charge] = mapGroupsToEigen(groups);                             // throws if inactive particles
-    Eigen::MatrixXd kr = pos.matrix() * data.k_vectors;                        // ( N x 3 ) * ( 3 x K ) = N x K
-    data.Q_ion.real() = (kr.array().cos().colwise() * charge).colwise().sum(); // real part of 'Q^q', see eq. 25 in ref.
-    data.Q_ion.imag() = kr.array().sin().colwise().sum(); // imaginary part of 'Q^q', see eq. 25 in ref.
+void PolicyIonIon::updatePhaseFactors(EwaldData &d, Space::Tgvec &groups) {
+    const Eigen::Index num_per_axis = static_cast<int>(std::ceil(d.n_cutoff)) + 1;
+    const Eigen::Index num_particles =
+        groups.empty() ? 0 : std::distance(groups.front().begin(), groups.back().trueend());
+    d.phase_factors.resize(3 * num_per_axis, num_particles);
+    for (auto &g : groups) {
+        const auto offset = std::distance(groups.front().begin(), g.begin());
+        for (size_t i = 0; i < g.size(); i++) { // active particles only
+            setPhaseFactors(d, g[i].pos, offset + i);
+        }
+        d.phase_factors.middleCols(offset + g.size(), g.capacity() - g.size()).setOnes();
+    }
 }
 
-void PolicyIonIon::updateComplex(EwaldData &d, Change &change, Space::Tgvec &groups, Space::Tgvec &oldgroups) const {
-    assert(groups.size() == oldgroups.size());
-    for (int k = 0; k < d.k_vectors.cols(); k++) {
-        auto &Q = d.Q_ion[k];
-        const Point &q = d.k_vectors.col(k);
+std::pair<Eigen::MatrixXcd, Eigen::VectorXd> PolicyIonIon::activePhaseFactors(const EwaldData &d,
+                                                                             Space::Tgvec &groups) {
+    std::pair<Eigen::MatrixXcd, Eigen::VectorXd> active;
+    auto &[factors, charges] = active;
+    const auto num_particles = countParticles(groups);
+    factors.resize(num_particles, d.phase_factors.rows());
+    charges.resize(num_particles);
+    Eigen::Index row = 0;
+    for (auto &g : groups) {
+        const auto offset = std::distance(groups.front().begin(), g.begin());
+        for (size_t i = 0; i < g.size(); i++, row++) {
+            factors.row(row) = d.phase_factors.col(offset + i).transpose();
+            charges[row] = g[i].charge;
+        }
+    }
+    return active;
+}
 
-        for (auto &changed_group : change.groups) {
-            auto &g_new = groups.at(changed_group.index);
-            auto &g_old = oldgroups.at(changed_group.index);
-            for (auto i : changed_group.atoms) {
-                if (i < g_new.size()) {
-                    double qr = q.dot(g_new[i].pos);
-                    Q += g_new[i].charge * EwaldData::Tcomplex(std::cos(qr), std::sin(qr));
-                }
-                if (i < g_old.size()) {
-                    double qr = q.dot(g_old[i].pos);
-                    Q -= g_old[i].charge * EwaldData::Tcomplex(std::cos(qr), std::sin(qr));
-                }
+PolicyIonIon::ChangedPhaseFactors PolicyIonIon::changedPhaseFactors(EwaldData &d, Change &change,
+                                                                    Space::Tgvec &groups, Space::Tgvec &oldgroups) {
+    ChangedPhaseFactors changed;
+    const auto num_changed = countParticles(change);
+    changed.new_factors.resize(d.phase_factors.rows(), num_changed);
+    changed.old_factors.resize(d.phase_factors.rows(), num_changed);
+    changed.new_charges.reserve(num_changed);
+    changed.old_charges.reserve(num_changed);
+    for (auto &changed_group : change.groups) {
+        auto &g_new = groups.at(changed_group.index);
+        auto &g_old = oldgroups.at(changed_group.index);
+        const auto offset = std::distance(groups.front().begin(), g_new.begin());
+        for (auto i : changed_group.atoms) {
+            const bool is_new = i < g_new.size();
+            const bool is_old = i < g_old.size();
+            const auto column = changed.new_charges.size();
+            changed.old_factors.col(column) = d.phase_factors.col(offset + i); // cached from the accepted state
+            changed.old_charges.push_back(is_old ? g_old[i].charge : 0.0);
+            if (is_new && (!is_old || g_new[i].pos != g_old[i].pos)) {
+                setPhaseFactors(d, g_new[i].pos, offset + i);
             }
+            changed.new_factors.col(column) = d.phase_factors.col(offset + i);
+            changed.new_charges.push_back(is_new ? g_new[i].charge : 0.0);
         }
     }
+    return changed;
+}
+
+/**
+ * The k-vectors are distributed over threads so that each structure factor is summed by a single thread, always in
+ * particle order. The result is thus independent of the number of threads.
+ */
+template <typename TPhase>
+void PolicyIonIon::sumStructureFactors(EwaldData &d, Space::Tgvec &groups, TPhase phase) {
+    updatePhaseFactors(d, groups);
+    std::vector<std::pair<Eigen::Index, double>> particles; // index and charge of active particles
+    for (auto &g : groups) {
+        const auto offset = std::distance(groups.front().begin(), g.begin());
+        for (size_t i = 0; i < g.size(); i++) {
+            particles.emplace_back(offset + i, g[i].charge);
+        }
+    }
+    const int num_kvectors = d.k_vectors.cols();
+    d.Q_ion.resize(num_kvectors);
+#pragma omp parallel for if (parallelOverKvectors(num_kvectors, particles.size()))
+    for (int k = 0; k < num_kvectors; k++) {
+        const auto n = d.k_integers.col(k);
+        std::complex<double> Q = 0.0;
+        for (const auto &[index, charge] : particles) {
+            Q += charge * phase(d.phase_factors.col(index), n); // 'Q^q', see eq. 25 in ref.
+        }
+        d.Q_ion[k] = Q;
+    }
+}
+
+template <typename TPhase>
+void PolicyIonIon::addChangedStructureFactors(EwaldData &d, const ChangedPhaseFactors &changed, TPhase phase) {
+    const int num_kvectors = d.k_vectors.cols();
+    const int num_changed = changed.new_charges.size();
+#pragma omp parallel for if (parallelOverKvectors(num_kvectors, 2 * num_changed))
+    for (int k = 0; k < num_kvectors; k++) {
+        const auto n = d.k_integers.col(k);
+        for (int c = 0; c < num_changed; c++) {
+            d.Q_ion[k] += changed.new_charges[c] * phase(changed.new_factors.col(c), n) -
+                          changed.old_charges[c] * phase(changed.old_factors.col(c), n);
+        }
+    }
+}
+
+/**
+ * The phase factors of all particles are evaluated and cached, whereafter the structure factor of each k-vector is
+ * a product of three cached factors per particle.
+ */
+void PolicyIonIon::updateComplex(EwaldData &data, Space::Tgvec &groups) const {
+    sumStructureFactors(data, groups, [](const auto &factors, const auto &n) { return phaseFromFactors(factors, n); });
+}
+
+/**
+ * @brief Splits the k-vectors into runs of consecutive k-vectors that share the x and y integer components
+ * @return start index of each run, followed by the total number of k-vectors
+ */
+static std::vector<Eigen::Index> kvectorRuns(const Eigen::Matrix3Xi &k_integers) {
+    std::vector<Eigen::Index> runs;
+    for (Eigen::Index k = 0; k < k_integers.cols(); k++) {
+        if (k == 0 || k_integers.col(k).head<2>() != k_integers.col(k - 1).head<2>()) {
+            runs.push_back(k);
+        }
+    }
+    runs.push_back(k_integers.cols());
+    return runs;
+}
+
+/**
+ * Structure factors of all k-vectors sharing nx and ny follow from a single matrix-vector product,
+ * Q(nx, ny, nz) = sum_j w_j exp(i nz θ_j) with weights w_j = q_j exp(i nx φ_j) exp(i ny ψ_j), which Eigen
+ * vectorises. Negative components use the complex conjugate of the cached phase factors.
+ */
+void PolicyIonIonEigen::updateComplex(EwaldData &data, Space::Tgvec &groups) const {
+    updatePhaseFactors(data, groups);
+    const auto active = activePhaseFactors(data, groups);
+    const Eigen::MatrixXcd &factors = active.first; // N x 3(n_max + 1), active particles only
+    const Eigen::VectorXd &charges = active.second;
+    const Eigen::Index num_per_axis = data.phase_factors.rows() / 3;
+    auto axis_factors = [&](int dim, int n) -> Eigen::VectorXcd {
+        if (n < 0) {
+            return factors.col(dim * num_per_axis - n).conjugate();
+        }
+        return factors.col(dim * num_per_axis + n);
+    };
+    const auto runs = kvectorRuns(data.k_integers);
+    const int num_runs = runs.size() - 1;
+#pragma omp parallel for if (parallelOverKvectors(data.k_integers.cols(), charges.size()))
+    for (int run = 0; run < num_runs; run++) {
+        const auto first = runs[run];
+        Eigen::VectorXcd weights = axis_factors(0, data.k_integers(0, first)).cwiseProduct(
+            axis_factors(1, data.k_integers(1, first)));
+        weights.array() *= charges.array().cast<EwaldData::Tcomplex>();
+        const auto factors_z = factors.rightCols(num_per_axis);
+        const Eigen::RowVectorXcd positive = weights.transpose() * factors_z; // nz >= 0
+        Eigen::RowVectorXcd negative;                                         // nz < 0
+        if (data.k_integers(2, first) < 0) {
+            negative = (weights.adjoint() * factors_z).conjugate();
+        }
+        for (auto k = first; k < runs[run + 1]; k++) {
+            const int nz = data.k_integers(2, k);
+            data.Q_ion[k] = (nz < 0) ? negative[-nz] : positive[nz]; // 'Q^q', see eq. 25 in ref.
+        }
+    }
+}
+
+/**
+ * The old phase factors of the changed particles are taken from the cache, hence only the new positions are
+ * evaluated; none if the positions are unchanged.
+ */
+void PolicyIonIon::updateComplex(EwaldData &d, Change &change, Space::Tgvec &groups, Space::Tgvec &oldgroups) const {
+    assert(groups.size() == oldgroups.size());
+    addChangedStructureFactors(d, changedPhaseFactors(d, change, groups, oldgroups),
+                               [](const auto &factors, const auto &n) { return phaseFromFactors(factors, n); });
 }
 
 //----------------- IPBC Ewald -------------------
@@ -182,6 +453,7 @@ void PolicyIonIonIPBC::updateBox(EwaldData &data, const Point &box) const {
     int k_vector_size = (2 * ncc + 1) * (2 * ncc + 1) * (2 * ncc + 1) - 1;
     if (k_vector_size == 0) {
         data.k_vectors.resize(3, 1);
+        data.k_integers.setZero(3, 1);
         data.Aks.resize(1);
         data.k_vectors.col(0) = Point(1, 0, 0); // Just so it is not the zero-vector
         data.Aks[0] = 0;
@@ -191,6 +463,7 @@ void PolicyIonIonIPBC::updateBox(EwaldData &data, const Point &box) const {
     } else {
         double nc2 = data.n_cutoff * data.n_cutoff;
         data.k_vectors.resize(3, k_vector_size);
+        data.k_integers.resize(3, k_vector_size);
         data.Aks.resize(k_vector_size);
         data.num_kvectors = 0;
         data.k_vectors.setZero();
@@ -216,6 +489,7 @@ void PolicyIonIonIPBC::updateBox(EwaldData &data, const Point &box) const {
                             continue;
                     }
                     data.k_vectors.col(data.num_kvectors) = kv;
+                    data.k_integers.col(data.num_kvectors) = Eigen::Vector3i(nx, ny, nz);
                     data.Aks[data.num_kvectors] = factor * exp(-k2 / (4 * data.alpha * data.alpha)) / k2;
                     data.num_kvectors++;
                 }
@@ -225,50 +499,230 @@ void PolicyIonIonIPBC::updateBox(EwaldData &data, const Point &box) const {
         data.Q_dipole.resize(data.num_kvectors);
         data.Aks.conservativeResize(data.num_kvectors);
         data.k_vectors.conservativeResize(3, data.num_kvectors);
+        data.k_integers.conservativeResize(3, data.num_kvectors);
     }
 }
 
 void PolicyIonIonIPBC::updateComplex(EwaldData &d, Space::Tgvec &groups) const {
     assert(d.policy == EwaldData::IPBC or d.policy == EwaldData::IPBCEigen);
-    for (int k = 0; k < d.k_vectors.cols(); k++) {
-        const Point &q = d.k_vectors.col(k);
-        EwaldData::Tcomplex Q(0, 0);
-        for (auto &g : groups) {
-            for (auto &particle : g) {
-                Q += q.cwiseProduct(particle.pos).array().cos().prod() * particle.charge; // see eq. 2 in doi:10/css8
-            }
-        }
-        d.Q_ion[k] = Q;
-    }
+    sumStructureFactors(d, groups,
+                        [](const auto &factors, const auto &n) { return cosineProductFromFactors(factors, n); });
 }
 
+/**
+ * All components of the k-vectors are non-negative, and the cosine products of all k-vectors sharing nx and ny
+ * follow from a single matrix-vector product, see PolicyIonIonEigen::updateComplex().
+ */
 void PolicyIonIonIPBCEigen::updateComplex(EwaldData &d, Space::Tgvec &groups) const {
     assert(d.policy == EwaldData::IPBC or d.policy == EwaldData::IPBCEigen);
-    auto [pos, charge] = mapGroupsToEigen(groups); // throws if inactive particles
-    d.Q_ion.real() = (d.k_vectors.array().cwiseProduct(pos).array().cos().prod() * charge)
-                         .colwise()
-                         .sum(); // see eq. 2 in doi:10/css8
+    updatePhaseFactors(d, groups);
+    const auto active = activePhaseFactors(d, groups);
+    const Eigen::MatrixXd cosines = active.first.real(); // N x 3(n_max + 1), active particles only
+    const Eigen::VectorXd &charges = active.second;
+    const Eigen::Index num_per_axis = d.phase_factors.rows() / 3;
+    const auto runs = kvectorRuns(d.k_integers);
+    const int num_runs = runs.size() - 1;
+#pragma omp parallel for if (parallelOverKvectors(d.k_integers.cols(), charges.size()))
+    for (int run = 0; run < num_runs; run++) {
+        const auto first = runs[run];
+        const Eigen::VectorXd weights = charges.cwiseProduct(cosines.col(d.k_integers(0, first)))
+                                            .cwiseProduct(cosines.col(num_per_axis + d.k_integers(1, first)));
+        const Eigen::RowVectorXd products = weights.transpose() * cosines.rightCols(num_per_axis);
+        for (auto k = first; k < runs[run + 1]; k++) {
+            d.Q_ion[k] = products[d.k_integers(2, k)]; // see eq. 2 in doi:10/css8
+        }
+    }
 }
 
 void PolicyIonIonIPBC::updateComplex(EwaldData &d, Change &change, Space::Tgvec &groups,
                                      Space::Tgvec &oldgroups) const {
     assert(d.policy == EwaldData::IPBC or d.policy == EwaldData::IPBCEigen);
     assert(groups.size() == oldgroups.size());
+    addChangedStructureFactors(d, changedPhaseFactors(d, change, groups, oldgroups),
+                               [](const auto &factors, const auto &n) { return cosineProductFromFactors(factors, n); });
+}
 
-    for (int k = 0; k < d.k_vectors.cols(); k++) {
-        auto &Q = d.Q_ion[k];
-        const Point &q = d.k_vectors.col(k);
-        for (auto &changed_group : change.groups) {
-            auto &g_new = groups.at(changed_group.index);
-            auto &g_old = oldgroups.at(changed_group.index);
-            for (auto i : changed_group.atoms) {
-                if (i < g_new.size())
-                    Q += q.cwiseProduct(g_new[i].pos).array().cos().prod() * g_new[i].charge;
-                if (i < g_old.size())
-                    Q -= q.cwiseProduct(g_old[i].pos).array().cos().prod() * g_old[i].charge;
+//----------------- Particle-mesh Ewald -------------------
+
+/**
+ * @brief Cardinal B-spline weights of the mesh points around a coordinate
+ *
+ * The coordinate is scaled to mesh units, u = K (x / L + 1/2), and the weight of the mesh point `floor(u) - j` is
+ * M_n(u - floor(u) + j) for j = 0, ..., n - 1, obtained by the recursion in eq. 4.1 of doi:10.1063/1.470117.
+ *
+ * @param x  coordinate within the box
+ * @param box_length  box length along the axis
+ * @param mesh_size  number of mesh points along the axis
+ * @param weights  weights of the n mesh points; the size sets the spline order
+ * @return index of the first mesh point, i.e., `floor(u)` wrapped into the mesh
+ */
+static int splineWeights(double x, double box_length, int mesh_size, std::vector<double> &weights) {
+    const int order = weights.size();
+    const double u = mesh_size * (x / box_length + 0.5);
+    const double u_floor = std::floor(u);
+    const double w = u - u_floor;
+    std::fill(weights.begin(), weights.end(), 0.0);
+    weights[0] = 1.0; // M_1
+    for (int n = 2; n <= order; n++) {
+        for (int j = n - 1; j >= 0; j--) {
+            const double previous = (j > 0) ? weights[j - 1] : 0.0;
+            weights[j] = ((w + j) * weights[j] + (n - w - j) * previous) / (n - 1);
+        }
+    }
+    return ((int(u_floor) % mesh_size) + mesh_size) % mesh_size;
+}
+
+/**
+ * @brief In-place forward discrete Fourier transform of a 3D mesh stored in row-major order
+ */
+static void fourierTransform(std::vector<EwaldData::Tcomplex> &mesh, const Eigen::Vector3i &mesh_size) {
+    Eigen::FFT<double> fft;
+    const int strides[3] = {mesh_size[1] * mesh_size[2], mesh_size[2], 1};
+    std::vector<EwaldData::Tcomplex> line, transformed_line;
+    for (int dim = 0; dim < 3; dim++) {
+        line.resize(mesh_size[dim]);
+        for (size_t start = 0; start < mesh.size(); start++) {
+            if ((start / strides[dim]) % mesh_size[dim] != 0) {
+                continue; // not the beginning of a line along dim
+            }
+            for (int i = 0; i < mesh_size[dim]; i++) {
+                line[i] = mesh[start + i * strides[dim]];
+            }
+            fft.fwd(transformed_line, line);
+            for (int i = 0; i < mesh_size[dim]; i++) {
+                mesh[start + i * strides[dim]] = transformed_line[i];
+            }
+        }
+    }
+}
+
+/**
+ * Uses the k-vectors of `PolicyIonIon`, locates them on the mesh, and multiplies `Aks` with the squared B-spline
+ * moduli, |b(m)|^2, see eq. 4.4 in doi:10.1063/1.470117.
+ */
+void PolicyIonIonPME::updateBox(EwaldData &d, const Point &box) const {
+    assert(d.policy == EwaldData::PME);
+    PolicyIonIon::updateBox(d, box);
+    const int n_cutoff_ceil = std::ceil(d.n_cutoff);
+    if (d.mesh_size.minCoeff() <= 2 * n_cutoff_ceil) {
+        throw std::runtime_error("PME mesh must have more than 2 x ncutoff points along each axis");
+    }
+    std::vector<double> spline_at_knots(d.spline_order); // M_n(j) for j = 0, ..., n - 1
+    splineWeights(-0.5 * box.x(), box.x(), d.mesh_size.x(), spline_at_knots);
+    std::array<Eigen::VectorXd, 3> moduli; // |b(m)|^2 along each axis
+    for (int dim = 0; dim < 3; dim++) {
+        const int mesh_size = d.mesh_size[dim];
+        moduli[dim].resize(mesh_size);
+        for (int m = 0; m < mesh_size; m++) {
+            EwaldData::Tcomplex denominator(0, 0);
+            for (int k = 0; k < d.spline_order - 1; k++) {
+                denominator += spline_at_knots[k + 1] * std::polar(1.0, 2 * pc::pi * m * k / mesh_size);
+            }
+            moduli[dim][m] = 1.0 / std::norm(denominator);
+        }
+    }
+    d.mesh_indices.resize(3, d.num_kvectors);
+    for (int k = 0; k < d.num_kvectors; k++) {
+        double modulus = 1.0;
+        for (int dim = 0; dim < 3; dim++) {
+            const int mesh_size = d.mesh_size[dim];
+            const int m = std::lround(d.k_vectors(dim, k) * box[dim] / (2 * pc::pi));
+            d.mesh_indices(dim, k) = ((m % mesh_size) + mesh_size) % mesh_size;
+            modulus *= moduli[dim][d.mesh_indices(dim, k)];
+        }
+        d.Aks[k] *= modulus;
+    }
+}
+
+void PolicyIonIonPME::updateComplex(EwaldData &d, Space::Tgvec &groups) const {
+    assert(d.policy == EwaldData::PME);
+    const Eigen::Vector3i &mesh_size = d.mesh_size;
+    std::vector<EwaldData::Tcomplex> mesh(mesh_size.prod(), EwaldData::Tcomplex(0, 0));
+    std::array<std::vector<double>, 3> weights;
+    std::array<int, 3> first;
+    weights.fill(std::vector<double>(d.spline_order));
+    for (auto &g : groups) {
+        for (auto &particle : g) { // spread charges onto the mesh
+            for (int dim = 0; dim < 3; dim++) {
+                first[dim] = splineWeights(particle.pos[dim], d.box_length[dim], mesh_size[dim], weights[dim]);
+            }
+            for (int i = 0; i < d.spline_order; i++) {
+                const int x = (first[0] - i + mesh_size[0]) % mesh_size[0];
+                for (int j = 0; j < d.spline_order; j++) {
+                    const int y = (first[1] - j + mesh_size[1]) % mesh_size[1];
+                    const double charge_xy = particle.charge * weights[0][i] * weights[1][j];
+                    auto mesh_xy = mesh.begin() + (x * mesh_size[1] + y) * mesh_size[2];
+                    for (int k = 0; k < d.spline_order; k++) {
+                        mesh_xy[(first[2] - k + mesh_size[2]) % mesh_size[2]] += charge_xy * weights[2][k];
+                    }
+                }
             }
         }
     }
+    fourierTransform(mesh, mesh_size);
+    for (int k = 0; k < d.num_kvectors; k++) {
+        const auto &m = d.mesh_indices.col(k);
+        d.Q_ion[k] = mesh[(m[0] * mesh_size[1] + m[1]) * mesh_size[2] + m[2]];
+    }
+}
+
+/**
+ * The structure factor of a spread charge factorises into one Fourier transformed stencil per axis. Hence each
+ * changed charge costs O(n x M_x + n x M_y + n x M_z) to transform, and O(K) to add to the structure factors.
+ */
+void PolicyIonIonPME::updateComplex(EwaldData &d, Change &change, Space::Tgvec &groups,
+                                    Space::Tgvec &oldgroups) const {
+    assert(d.policy == EwaldData::PME);
+    assert(groups.size() == oldgroups.size());
+    const Eigen::Vector3i &mesh_size = d.mesh_size;
+    std::array<Eigen::VectorXcd, 3> roots; // exp(-2 pi i t / M) along each axis
+    for (int dim = 0; dim < 3; dim++) {
+        roots[dim].resize(mesh_size[dim]);
+        for (int t = 0; t < mesh_size[dim]; t++) {
+            roots[dim][t] = std::polar(1.0, -2 * pc::pi * t / mesh_size[dim]);
+        }
+    }
+    struct Stencil {
+        double charge;
+        std::array<Eigen::VectorXcd, 3> transform; // Fourier transformed B-spline weights along each axis
+    };
+    std::vector<Stencil> stencils;
+    std::vector<double> weights(d.spline_order);
+    auto add_stencil = [&](const Particle &particle, double sign) {
+        Stencil stencil{sign * particle.charge, {}};
+        for (int dim = 0; dim < 3; dim++) {
+            const int first = splineWeights(particle.pos[dim], d.box_length[dim], mesh_size[dim], weights);
+            stencil.transform[dim].setZero(mesh_size[dim]);
+            for (int j = 0; j < d.spline_order; j++) {
+                const int point = (first - j + mesh_size[dim]) % mesh_size[dim];
+                for (int m = 0; m < mesh_size[dim]; m++) {
+                    stencil.transform[dim][m] += weights[j] * roots[dim][(m * point) % mesh_size[dim]];
+                }
+            }
+        }
+        stencils.push_back(std::move(stencil));
+    };
+    for (auto &changed_group : change.groups) {
+        auto &g_new = groups.at(changed_group.index);
+        auto &g_old = oldgroups.at(changed_group.index);
+        for (auto i : changed_group.atoms) {
+            if (i < g_new.size()) {
+                add_stencil(g_new[i], 1.0);
+            }
+            if (i < g_old.size()) {
+                add_stencil(g_old[i], -1.0);
+            }
+        }
+    }
+    const int num_kvectors = d.num_kvectors;
+#pragma omp parallel for if (parallelOverKvectors(num_kvectors, stencils.size()))
+    for (int k = 0; k < num_kvectors; k++) {
+        const auto &m = d.mesh_indices.col(k);
+        for (const auto &stencil : stencils) {
+            d.Q_ion[k] += stencil.charge * stencil.transform[0][m[0]] * stencil.transform[1][m[1]] *
+                          stencil.transform[2][m[2]];
+        }
+    }
 }
 
 double PolicyIonIon::surfaceEnergy(const EwaldData &d, Change &change, Space::Tgvec &groups) {
@@ -330,14 +784,25 @@ double PolicyIonIon::selfEnergy(const EwaldData &d, Change &change, Space::Tgvec
  */
 double PolicyIonIon::reciprocalEnergy(const EwaldData &d) {
     double energy = 0;
-    for (int k = 0; k < d.Q_ion.size(); k++) {
+    const int num_kvectors = d.Q_ion.size();
+#pragma omp parallel for reduction(+ : energy) if (parallelOverKvectors(num_kvectors, 1))
+    for (int k = 0; k < num_kvectors; k++) {
         energy += d.Aks[k] * std::norm(d.Q_ion[k]);
     }
     return 2 * pc::pi * energy * d.bjerrum_length / d.box_length.prod();
 }
 
 double PolicyIonIonEigen::reciprocalEnergy(const EwaldData &d) {
-    double energy = d.Aks.cwiseProduct(d.Q_ion.cwiseAbs2()).sum();
+    const Eigen::Index num_kvectors = d.Q_ion.size();
+    const Eigen::Index block_size = kvectorBlockSize(num_kvectors, 1);
+    const Eigen::Index num_blocks = (num_kvectors + block_size - 1) / block_size;
+    double energy = 0;
+#pragma omp parallel for reduction(+ : energy) if (num_blocks > 1 && parallelOverKvectors(num_kvectors, 1))
+    for (Eigen::Index block = 0; block < num_blocks; block++) {
+        const Eigen::Index first = block * block_size;
+        const Eigen::Index size = std::min(block_size, num_kvectors - first);
+        energy += d.Aks.segment(first, size).cwiseProduct(d.Q_ion.segment(first, size).cwiseAbs2()).sum();
+    }
     return 2 * pc::pi * d.bjerrum_length * energy / d.box_length.prod();
 }
 
@@ -375,9 +840,6 @@ double Ewald::energy(Change &change) {
     return u;
 }
 
-/**
- * @todo Implement a sync() function in EwaldData to selectively copy information
- */
 void Ewald::sync(Energybase *energybase_pointer, Change &change) {
     auto other = dynamic_cast<decltype(this)>(energybase_pointer);
     assert(other);
@@ -386,17 +848,207 @@ void Ewald::sync(Energybase *energybase_pointer, Change &change) {
           &(other->spc
                 .groups); // give NEW access to OLD space for optimized updates
     }
+    data.sync(other->data, change, spc.groups);
+}
 
-    // hard-coded sync; should be expanded when dipolar ewald is supported
-    if (change.all or change.dV) {
-        other->data.Q_dipole.resize(0); // dipoles are currently unsupported
-        data = other->data;
-    } else {
-        data.Q_ion = other->data.Q_ion;
+void Ewald::to_json(json &j) const { j = data; }
+
+/**
+ * Kolafa-Perram estimate of the real-space energy error, doi:10.1080/08927029208049126
+ *
+ * @param sum_squared_charges  sum of squared charges of all particles
+ * @return root-mean-square energy error in units of kT
+ */
+static double realSpaceError(double alpha, double cutoff, double sum_squared_charges, double volume,
+                             double bjerrum_length) {
+    const auto alpha_cutoff_squared = std::pow(alpha * cutoff, 2);
+    return bjerrum_length * sum_squared_charges * std::sqrt(cutoff / (2.0 * volume)) *
+           std::exp(-alpha_cutoff_squared) / alpha_cutoff_squared;
+}
+
+/**
+ * Kolafa-Perram estimate of the reciprocal-space energy error, doi:10.1080/08927029208049126
+ *
+ * @param box_length  longest box side, whose k-vectors are the least resolved for a given `n_cutoff`
+ * @return root-mean-square energy error in units of kT
+ */
+static double reciprocalSpaceError(double alpha, double n_cutoff, double sum_squared_charges, double box_length,
+                                   double bjerrum_length) {
+    return bjerrum_length * sum_squared_charges * alpha / (pc::pi * pc::pi) * std::pow(n_cutoff, -1.5) *
+           std::exp(-std::pow(pc::pi * n_cutoff / (alpha * box_length), 2));
+}
+
+/**
+ * Finds `x` in `[lower, upper]` where the decreasing function `f` reaches `target`
+ */
+template <typename Tfunction> static double bisect(Tfunction f, double target, double lower, double upper) {
+    for (int i = 0; i < 60; i++) {
+        const auto middle = 0.5 * (lower + upper);
+        (f(middle) > target ? lower : upper) = middle;
     }
+    return upper;
 }
 
-void Ewald::to_json(json &j) const { j = data; }
+/**
+ * Shortest wall-clock time (seconds) of a few repeated calls to `function`
+ */
+template <typename Tfunction> static double probeTime(Tfunction function) {
+    using clock = std::chrono::steady_clock;
+    constexpr double time_budget = 0.02; // seconds per probe
+    double fastest = pc::infty, total = 0.0;
+    for (int repetition = 0; repetition < 5 && total < time_budget; repetition++) {
+        const auto start = clock::now();
+        function();
+        const auto seconds = std::chrono::duration<double>(clock::now() - start).count();
+        fastest = std::min(fastest, seconds);
+        total += seconds;
+    }
+    return fastest;
+}
+
+json tuneEwald(const json &j, Space &spc) {
+    const double tolerance = j.at("tolerance").get<double>(); // kT
+    if (tolerance <= 0.0)
+        throw std::runtime_error("Ewald `tolerance` must be positive");
+    const double bjerrum_length = pc::bjerrumLength(j.at("epsr"));
+    const Point box_length = spc.geo.getLength();
+    const double volume = spc.geo.getVolume();
+    const double max_cutoff = 0.5 * box_length.minCoeff(); // minimum image convention
+
+    std::vector<const Particle *> particles; // active particles
+    for (auto &group : spc.groups) {
+        for (auto &particle : group) {
+            particles.push_back(&particle);
+        }
+    }
+    const double sum_squared_charges =
+        std::accumulate(particles.begin(), particles.end(), 0.0,
+                        [](double sum, auto particle) { return sum + std::pow(particle->charge, 2); });
+    if (particles.empty() || sum_squared_charges == 0.0)
+        throw std::runtime_error("Ewald tuning requires charged particles");
+
+    // the probes use an evenly spaced subset and are scaled to the full system
+    auto sample = [&](size_t max_size) {
+        std::vector<const Particle *> subset;
+        const auto stride = std::max(size_t(1), particles.size() / max_size);
+        for (size_t i = 0; i < particles.size() && subset.size() < max_size; i += stride) {
+            subset.push_back(particles[i]);
+        }
+        return subset;
+    };
+
+    // real space: pair distances within the largest admissible cutoff and the time per pair evaluation
+    std::vector<double> distances;
+    const auto real_sample = sample(256);
+    for (auto particle : real_sample) {
+        for (auto other : particles) {
+            if (other != particle) {
+                const auto distance = spc.geo.vdist(particle->pos, other->pos).norm();
+                if (distance < max_cutoff)
+                    distances.push_back(distance);
+            }
+        }
+    }
+    std::sort(distances.begin(), distances.end());
+    const double pair_scaling = 0.5 * double(particles.size()) / double(real_sample.size());
+    double kernel_sum = 0.0; // keeps the probed kernel from being optimized away
+    const double time_per_pair = distances.empty() ? 0.0 : probeTime([&] {
+        const double alpha = 3.0 / max_cutoff;
+        for (auto distance : distances) {
+            kernel_sum += std::erfc(alpha * distance) / distance;
+        }
+    }) / double(distances.size());
+    auto realSpaceTime = [&](double cutoff) {
+        const auto num_pairs =
+            std::distance(distances.begin(), std::lower_bound(distances.begin(), distances.end(), cutoff));
+        return time_per_pair * pair_scaling * double(num_pairs);
+    };
+
+    // reciprocal space: time a full k-space update of the configured policy on a copy of a particle subset
+    ParticleVector reciprocal_particles;
+    for (auto particle : sample(1000)) {
+        reciprocal_particles.push_back(*particle);
+    }
+    Space::Tgvec reciprocal_groups;
+    reciprocal_groups.push_back(Group<Particle>(reciprocal_particles.begin(), reciprocal_particles.end()));
+    const double reciprocal_scaling = double(particles.size()) / double(reciprocal_particles.size());
+
+    // candidate splitting parameters span real-space cutoffs from half the box to a quarter thereof,
+    // unless the real-space cutoff is given
+    const double real_tolerance = tolerance / std::sqrt(2.0);
+    const double reciprocal_tolerance = tolerance / std::sqrt(2.0);
+    auto alphaForCutoff = [&](double cutoff) {
+        auto error = [&](double alpha) {
+            return realSpaceError(alpha, cutoff, sum_squared_charges, volume, bjerrum_length);
+        };
+        return bisect(error, real_tolerance, 1e-6 / cutoff, 100.0 / cutoff);
+    };
+    std::vector<double> cutoffs;
+    if (j.count("cutoff")) {
+        cutoffs.push_back(j.at("cutoff").get<double>());
+        if (cutoffs.front() > max_cutoff)
+            throw std::runtime_error("Ewald `cutoff` exceeds half the box length");
+    } else {
+        constexpr int num_candidates = 12;
+        for (int i = 0; i < num_candidates; i++) {
+            cutoffs.push_back(max_cutoff * std::pow(0.25, double(i) / (num_candidates - 1)));
+        }
+    }
+
+    constexpr int max_ncutoff = 64;
+    json best;
+    double best_time = pc::infty;
+    for (auto cutoff : cutoffs) {
+        const double alpha = alphaForCutoff(cutoff);
+        auto reciprocal_error = [&](int n_cutoff) {
+            return reciprocalSpaceError(alpha, n_cutoff, sum_squared_charges, box_length.maxCoeff(), bjerrum_length);
+        };
+        int n_cutoff = 1;
+        while (n_cutoff < max_ncutoff && reciprocal_error(n_cutoff) > reciprocal_tolerance) {
+            n_cutoff++;
+        }
+        if (reciprocal_error(n_cutoff) > reciprocal_tolerance) {
+            continue; // too many k-vectors
+        }
+        json candidate = j;
+        candidate.erase("tolerance"); // the tuned input is final
+        candidate["alpha"] = alpha;
+        candidate["cutoff"] = cutoff;
+        candidate["ncutoff"] = n_cutoff;
+        double reciprocal_time = pc::infty;
+        try {
+            EwaldData data(candidate);
+            auto policy = EwaldPolicyBase::makePolicy(data.policy);
+            policy->updateBox(data, box_length);
+            reciprocal_time = reciprocal_scaling * probeTime([&] {
+                                  policy->updateComplex(data, reciprocal_groups);
+                                  kernel_sum += policy->reciprocalEnergy(data);
+                              });
+        } catch (std::exception &e) {
+            faunus_logger->debug("Ewald tuning skips ncutoff = {}: {}", n_cutoff, e.what());
+            continue;
+        }
+        const double real_time = realSpaceTime(cutoff);
+        faunus_logger->debug("Ewald tuning: alpha = {}, cutoff = {}, ncutoff = {}, time = {} + {} s", alpha, cutoff,
+                             n_cutoff, real_time, reciprocal_time);
+        if (real_time + reciprocal_time < best_time) {
+            best_time = real_time + reciprocal_time;
+            best = candidate;
+            best["autotune"] = {
+                {"tolerance", tolerance},
+                {"real space error", realSpaceError(alpha, cutoff, sum_squared_charges, volume, bjerrum_length)},
+                {"reciprocal space error", reciprocal_error(n_cutoff)},
+                {"real space time", real_time},
+                {"reciprocal space time", reciprocal_time}};
+        }
+    }
+    if (best.is_null())
+        throw std::runtime_error("no Ewald parameters meet the requested tolerance");
+    faunus_logger->debug("Ewald tuning kernel checksum {}", kernel_sum);
+    faunus_logger->info("Ewald parameters for tolerance {} kT: alpha = {}, cutoff = {}, ncutoff = {}", tolerance,
+                        best["alpha"].get<double>(), best["cutoff"].get<double>(), best["ncutoff"].get<int>());
+    return best;
+}
 
 double Example2D::energy(Change &) {
     double s = 1 + std::sin(2 * pc::pi * i.x()) + std::cos(2 * pc::pi * i.y());
@@ -501,38 +1153,66 @@ void Constrain::to_json(json &j) const {
     j.erase("resolution");
     j["type"] = type;
 }
+BondIncidence::BondIncidence(const BasePointerVector<Potential::BondData> &bonds, int first_particle,
+                             int num_particles)
+    : first_particle(first_particle), offsets(num_particles + 1, 0), stamps(bonds.size(), 0) {
+    auto local_index = [&](int particle) {
+        const int i = particle - first_particle;
+        if (i < 0 || i >= num_particles)
+            throw std::runtime_error("bond index outside the indexed particles");
+        return i;
+    };
+    for (auto &bond : bonds) { // count bonds per particle...
+        for (auto particle : bond->index) {
+            offsets[local_index(particle) + 1]++;
+        }
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin()); // ...and turn counts into offsets
+    bond_indices.resize(offsets.back());
+    auto next_slot = offsets;
+    for (int bond = 0; bond < static_cast<int>(bonds.size()); bond++) {
+        for (auto particle : bonds.at(bond)->index) {
+            bond_indices[next_slot[local_index(particle)]++] = bond;
+        }
+    }
+}
+
+bool BondIncidence::anyBonds(int first, int last) const {
+    const int num_particles = static_cast<int>(offsets.size()) - 1;
+    first = std::clamp(first - first_particle, 0, std::max(num_particles, 0));
+    last = std::clamp(last - first_particle, first, std::max(num_particles, 0));
+    return first < last && offsets[last] > offsets[first];
+}
+
 void Bonded::update_intra() {
     using namespace Potential;
     intra.clear();
+    intra_compiled.clear();
+    intra_incidence.clear();
     for (size_t i = 0; i < spc.groups.size(); i++) {
         auto &group = spc.groups.at(i);
+        const int offset = std::distance(spc.p.begin(), group.begin());
         for (auto &bond : molecules.at(group.id).bonds) {
             intra[i].push_back<BondData>(bond->clone()); // deep copy BondData from MoleculeData
-            intra[i].back()->shift(std::distance(spc.p.begin(), group.begin()));
+            intra[i].back()->shift(offset);
             Potential::setBondEnergyFunction(intra[i].back(), spc.p);
         }
+        if (intra.count(i) == 1) {
+            intra_compiled[i] = Potential::CompiledBonds(intra[i].vec);
+            intra_incidence[i] = BondIncidence(intra[i], offset, group.capacity());
+        }
     }
 }
-double Bonded::sum_energy(const Bonded::BondVector &bonds) const {
-    double energy = 0;
-    for (auto &bond : bonds) {
-        assert(bond->hasEnergyFunction());
-        energy += bond->energy(spc.geo.getDistanceFunc());
-    }
-    return energy;
+double Bonded::sum_energy(const Potential::CompiledBonds &bonds) const {
+    return bonds.energy(spc.p, [&](const Point &a, const Point &b) { return spc.geo.vdist(a, b); });
 }
-double Bonded::sum_energy(const Bonded::BondVector &bonds, const std::vector<int> &particles_ndx) const {
+double Bonded::sum_energy(const Potential::CompiledBonds &bonds, BondIncidence &incidence,
+                          const std::vector<int> &particles_ndx) const {
     double energy = 0;
-    // outer loop over bonds to ensure that each bond is counted at most once
-    for (auto &bond : bonds) {
-        for (auto particle_ndx : particles_ndx) {
-            if (std::find(bond->index.begin(), bond->index.end(), particle_ndx) != bond->index.end()) {
-                assert(bond->hasEnergyFunction());
-                energy += bond->energy(spc.geo.getDistanceFunc());
-                break; // count each interaction at most once
-            }
-        }
-    }
+    auto distance = [&](const Point &a, const Point &b) { return spc.geo.vdist(a, b); };
+    // only bonds touching the particles are visited, each at most once
+    incidence.forEachBond(particles_ndx,
+                          [&](int bond_ndx) { energy += bonds.energy(bond_ndx, spc.p, distance); });
     return energy;
 }
 Bonded::Bonded(const json &j, Space &spc) : spc(spc) {
@@ -543,6 +1223,8 @@ Bonded::Bonded(const json &j, Space &spc) : spc(spc) {
             inter = j["bondlist"].get<BondVector>();
     for (auto &i : inter) // set all energy functions
         Potential::setBondEnergyFunction(i, spc.p);
+    inter_compiled = Potential::CompiledBonds(inter.vec);
+    inter_incidence = BondIncidence(inter, 0, spc.p.size());
 }
 void Bonded::to_json(json &j) const {
     if (!inter.empty())
@@ -558,17 +1240,36 @@ void Bonded::to_json(json &j) const {
 double Bonded::energy(Change &change) {
     double energy = 0;
     if (change) {
-        energy += sum_energy(inter); // energy of inter-molecular bonds
-
         if (change.all || change.dV) {              // compute all active groups
-            for (auto &i : intra) {                 // energies of intra-molecular bonds
+            energy += sum_energy(inter_compiled);   // energies of inter-molecular bonds
+            for (auto &i : intra_compiled) {        // energies of intra-molecular bonds
                 if (!spc.groups[i.first].empty()) { // add only if group is active
                     energy += sum_energy(i.second);
                 }
             }
         } else { // compute only the affected groups
+            if (inter_compiled.size() > 0) { // inter-molecular bonds touching changed particles
+                std::vector<int> particles_ndx;
+                for (auto &group : change.groups) {
+                    auto &g = spc.groups[group.index];
+                    const int offset = std::distance(spc.p.begin(), g.begin());
+                    if (!inter_incidence.anyBonds(offset, offset + g.capacity())) {
+                        continue;
+                    }
+                    if (group.all || group.atoms.empty()) {
+                        for (size_t i = 0; i < g.capacity(); i++) {
+                            particles_ndx.push_back(offset + i);
+                        }
+                    } else {
+                        for (auto i : group.atoms) {
+                            particles_ndx.push_back(offset + i);
+                        }
+                    }
+                }
+                energy += sum_energy(inter_compiled, inter_incidence, particles_ndx);
+            }
             for (auto &group : change.groups) {
-                auto &intra_group = intra[group.index];
+                auto &intra_group = intra_compiled[group.index];
                 if (group.internal) {
                     if (group.all) { // all internal positions updated
                         if (not spc.groups[group.index].empty())
@@ -580,7 +1281,7 @@ double Bonded::energy(Change &change) {
                         // add an offset to the group atom indices to get the absolute indices
                         std::transform(group.atoms.begin(), group.atoms.end(), std::back_inserter(atoms_ndx),
                                        [offset](int i) { return i + offset; });
-                        energy += sum_energy(intra_group, atoms_ndx);
+                        energy += sum_energy(intra_group, intra_incidence[group.index], atoms_ndx);
                     }
                 }
             }
@@ -619,6 +1320,59 @@ void Hamiltonian::addEwald(const json &j, Space &spc) {
     }
 }
 
+template <typename TPairEnergy, bool parallel> void Hamiltonian::addNonbonded(const json &j, Space &spc) {
+    typedef GroupCutoff TCutoff; // only a single cutoff scheme so far
+    const bool particle_cache = j.value("particle_cache", false);
+    const bool group_celllist = j.value("group_celllist", false);
+    if (j.count("celllist") == 1 && j.count("verletlist") == 1) {
+        throw std::runtime_error("celllist and verletlist are mutually exclusive");
+    } else if (particle_cache && (j.count("celllist") == 1 || j.count("verletlist") == 1)) {
+        throw std::runtime_error("particle_cache cannot be combined with neighbour lists");
+    } else if (group_celllist && (particle_cache || j.count("celllist") == 1 || j.count("verletlist") == 1)) {
+        throw std::runtime_error("group_celllist cannot be combined with particle_cache or neighbour lists");
+    } else if (group_celllist) {
+        emplace_back<Energy::Nonbonded<PairingPolicyGroupCellList<TPairEnergy, TCutoff>>>(j, spc, *this);
+    } else if (particle_cache) {
+        emplace_back<Energy::NonbondedParticleCached<PairingPolicy<TPairEnergy, TCutoff, parallel>>>(j, spc, *this);
+    } else if (j.count("celllist") == 1) {
+        emplace_back<Energy::Nonbonded<PairingPolicyCellList<TPairEnergy, TCutoff>>>(j, spc, *this);
+    } else if (j.count("verletlist") == 1) {
+        emplace_back<Energy::Nonbonded<PairingPolicyVerletList<TPairEnergy, TCutoff>>>(j, spc, *this);
+    } else {
+        emplace_back<Energy::Nonbonded<PairingPolicy<TPairEnergy, TCutoff, parallel>>>(j, spc, *this);
+    }
+}
+
+json tuneEwaldInput(const json &energy, Space &spc) {
+    json tuned = energy;
+    auto tune = [&](json &coulomb) {
+        if (coulomb.is_object() && coulomb.value("type", std::string()) == "ewald" && coulomb.count("tolerance") == 1)
+            coulomb = tuneEwald(coulomb, spc);
+    };
+    for (auto &energy_list_item : tuned) {
+        for (auto it : energy_list_item.items()) {
+            json &energy_term = it.value();
+            if (!energy_term.is_object())
+                continue;
+            try {
+                if (energy_term.count("default") == 1) { // FunctorPotential
+                    for (auto &i : energy_term["default"]) {
+                        if (i.count("coulomb") == 1) {
+                            tune(i["coulomb"]);
+                            break;
+                        }
+                    }
+                } else if (energy_term.count("coulomb") == 1) {
+                    tune(energy_term["coulomb"]);
+                }
+            } catch (std::exception &e) {
+                throw std::runtime_error("energy '" + it.key() + "': " + e.what());
+            }
+        }
+    }
+    return tuned;
+}
+
 Hamiltonian::Hamiltonian(Space &spc, const json &j) {
     using namespace Potential;
 
@@ -637,40 +1391,40 @@ Hamiltonian::Hamiltonian(Space &spc, const json &j) {
     if (spc.geo.type not_eq Geometry::CUBOID)
         emplace_back<Energy::ContainerOverlap>(spc);
 
-    // only a single cutoff scheme so far
-    typedef GroupCutoff TCutoff;
 #ifdef _OPENMP
-    // ready for OMP enabled policies
-    constexpr bool parallel = false;
+    // hard-coded potentials are thread-safe; `FunctorPotential` may contain the `custom` potential which
+    // serializes exact evaluations of its expression
+    constexpr bool parallel = true;
 #else
     constexpr bool parallel = false;
 #endif
-    for (auto &m : j) { // loop over energy list
+    constexpr bool parallel_functor = false;
+    for (const auto &m : tuneEwaldInput(j, spc)) { // loop over energy list
         size_t oldsize = vec.size();
         for (auto it : m.items()) {
             try {
                 if (it.key() == "nonbonded_coulomblj" || it.key() == "nonbonded_newcoulomblj")
-                    emplace_back<Energy::Nonbonded<PairingPolicy<PairEnergy<CoulombLJ, false>, TCutoff, parallel>>>(it.value(), spc, *this);
+                    addNonbonded<PairEnergy<CoulombLJ, false>, parallel>(it.value(), spc);
                 else if (it.key() == "nonbonded_coulomblj_EM")
                     emplace_back<Energy::NonbondedCached<CoulombLJ>>(it.value(), spc, *this);
 
                 else if (it.key() == "nonbonded_splined")
-                    emplace_back<Energy::Nonbonded<PairingPolicy<PairEnergy<TabulatedPotential, false>, TCutoff, parallel>>>(it.value(), spc, *this);
+                    addNonbonded<PairEnergy<TabulatedPotential, false>, parallel_functor>(it.value(), spc);
 
                 else if (it.key() == "nonbonded" or it.key() == "nonbonded_exact")
-                    emplace_back<Energy::Nonbonded<PairingPolicy<PairEnergy<FunctorPotential, true>, TCutoff, parallel>>>(it.value(), spc, *this);
+                    addNonbonded<PairEnergy<FunctorPotential, true>, parallel_functor>(it.value(), spc);
 
                 else if (it.key() == "nonbonded_cached")
                     emplace_back<Energy::NonbondedCached<TabulatedPotential>>(it.value(), spc, *this);
 
                 else if (it.key() == "nonbonded_coulombwca")
-                    emplace_back<Energy::Nonbonded<PairingPolicy<PairEnergy<CoulombWCA, false>, TCutoff, parallel>>>(it.value(), spc, *this);
+                    addNonbonded<PairEnergy<CoulombWCA, false>, parallel>(it.value(), spc);
 
                 else if (it.key() == "nonbonded_pm" or it.key() == "nonbonded_coulombhs")
-                    emplace_back<Energy::Nonbonded<PairingPolicy<PairEnergy<PrimitiveModel, false>, TCutoff, parallel>>>(it.value(), spc, *this);
+                    addNonbonded<PairEnergy<PrimitiveModel, false>, parallel>(it.value(), spc);
 
                 else if (it.key() == "nonbonded_pmwca")
-                    emplace_back<Energy::Nonbonded<PairingPolicy<PairEnergy<PrimitiveModelWCA, false>, TCutoff, parallel>>>(it.value(), spc, *this);
+                    addNonbonded<PairEnergy<PrimitiveModelWCA, false>, parallel>(it.value(), spc);
 
                 // this should be moved into `Nonbonded` and added when appropriate
                 // Nonbonded now has access to Hamiltonian (*this) and can therefore
@@ -715,6 +1469,11 @@ Hamiltonian::Hamiltonian(Space &spc, const json &j) {
                     continue;
                 }
 
+                else if (it.key() == "earlyrejection") {
+                    early_rejection = it.value().get<bool>();
+                    continue;
+                }
+
                 if (vec.size() == oldsize)
                     throw std::runtime_error("unknown term");
 
@@ -728,6 +1487,15 @@ Hamiltonian::Hamiltonian(Space &spc, const json &j) {
     for (auto &a : Faunus::molecules)
         if (not a.bonds.empty() and this->find<Energy::Bonded>().empty())
             faunus_logger->warn(a.name + " bonds specified in topology but missing in energy");
+
+    // cheap terms whose energy is either zero or infinite go first, so that an infinite change stops the summation
+    if (early_rejection) {
+        std::stable_partition(vec.begin(), vec.end(), [](const auto &term) {
+            const auto confine = dynamic_cast<Confine *>(term.get());
+            return dynamic_cast<ContainerOverlap *>(term.get()) || dynamic_cast<Constrain *>(term.get()) ||
+                   (confine && confine->isHard());
+        });
+    }
 }
 double Hamiltonian::energy(Change &change) {
     double du = 0;
@@ -741,6 +1509,30 @@ double Hamiltonian::energy(Change &change) {
     }
     return du;
 }
+std::pair<double, double> Hamiltonian::energy(Hamiltonian &old_hamiltonian, Change &change) {
+    if (old_hamiltonian.size() != size())
+        throw std::runtime_error("hamiltonian mismatch");
+    double unew = 0, uold = 0;
+    for (size_t i = 0; i < size(); i++) { // loop over terms in both Hamiltonians
+        auto &term = this->vec[i], &old_term = old_hamiltonian.vec[i];
+        term->key = key;
+        old_term->key = old_hamiltonian.key;
+        term->timer.start(); // time each term
+        if (auto du = term->energyChange(old_term.get(), change)) {
+            unew += *du; // single-pass energy change
+            term->timer.stop();
+        } else {
+            unew += term->energy(change);
+            term->timer.stop();
+            old_term->timer.start();
+            uold += old_term->energy(change);
+            old_term->timer.stop();
+        }
+        if (unew - uold >= maxenergy)
+            break; // stop summing energies
+    }
+    return {unew, uold};
+}
 void Hamiltonian::init() {
     for (auto i : this->vec)
         i->init();
@@ -861,6 +1653,16 @@ void SASAEnergy::to_json(json &j) const {
 
 GroupCutoff::GroupCutoff(Space::Tgeometry &geometry) : geometry(geometry) {}
 
+double GroupCutoff::maxCutoff() const {
+    double max_cutoff_squared = default_cutoff_squared;
+    for (size_t i = 0; i < cutoff_squared.size(); ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            max_cutoff_squared = std::max(max_cutoff_squared, cutoff_squared(i, j));
+        }
+    }
+    return max_cutoff_squared >= pc::max_value ? pc::infty : std::sqrt(max_cutoff_squared);
+}
+
 void from_json(const json &j, GroupCutoff &cutoff) {
     // disable all group-to-group cutoffs by setting infinity
     for (auto &i : Faunus::molecules) {
@@ -4,8 +4,10 @@
 #include "externalpotential.h" // Energybase implemented here
 #include "space.h"
 #include "aux/iteratorsupport.h"
+#include "celllist.h"
 #include <range/v3/view.hpp>
 #include <Eigen/Dense>
+#include <numeric>
 #include "spdlog/spdlog.h"
 
 #ifdef ENABLE_FREESASA
@@ -60,19 +62,23 @@ struct ContainerOverlap : public Energybase {
 /**
  * @brief Data class for Ewald k-space calculations
  *
- * Currently, the Eigen policies map to the non-eigen
- * variants, e.g. `PBCEigen == PBC`.
+ * The Eigen policies, `PBCEigen` and `IPBCEigen`, obtain the structure factors of all k-vectors sharing
+ * the x and y components from a single matrix-vector product over the cached phase factors. Partial
+ * updates are identical to those of the non-Eigen variants.
  *
  * Related reading:
  * - PBC Ewald (DOI:10.1063/1.481216)
  * - IPBC Ewald (DOI:10/css8)
  * - Update optimization (DOI:10.1063/1.481216, Eq. 24)
+ * - Smooth particle-mesh Ewald (DOI:10.1063/1.470117)
  */
 struct EwaldData {
     typedef std::complex<double> Tcomplex;
     Eigen::Matrix3Xd k_vectors;             //!< k-vectors, 3xK
+    Eigen::Matrix3Xi k_integers;            //!< Integer components, n, of the k-vectors, k = 2π n / L, 3xK
     Eigen::VectorXd Aks;                    //!< 1xK for update optimization (see Eq.24, DOI:10.1063/1.481216)
     Eigen::VectorXcd Q_ion, Q_dipole;       //!< Complex 1xK vectors
+    Eigen::MatrixXcd phase_factors;         //!< exp(i 2π n r / L), n = 0..n_max, per axis (rows) and particle (columns)
     double r_cutoff = 0;                    //!< Real-space cutoff
     double n_cutoff = 0;                    //!< Inverse space cutoff
     double surface_dielectric_constant = 0; //!< Surface dielectric constant;
@@ -85,9 +91,26 @@ struct EwaldData {
     bool use_spherical_sum = true;
     int num_kvectors = 0;
     Point box_length = {0.0, 0.0, 0.0};                        //!< Box dimensions
-    enum Policies { PBC, PBCEigen, IPBC, IPBCEigen, INVALID }; //!< Possible k-space updating schemes
+    Eigen::Vector3i mesh_size = {0, 0, 0};                     //!< PME: number of mesh points along each axis
+    Eigen::Matrix3Xi mesh_indices;                             //!< PME: mesh indices of the k-vectors, 3xK
+    int spline_order = 0;                                      //!< PME: order of the charge spreading B-splines
+    enum Policies { PBC, PBCEigen, IPBC, IPBCEigen, PME, INVALID }; //!< Possible k-space updating schemes
     Policies policy = PBC;                                     //!< Policy for updating k-space
+    json autotune;                                             //!< Summary of the automatic parameter choice, if any
     EwaldData(const json &);                                   //!< Initialize from json
+
+    /**
+     * @brief Copy the parts of `other` that may have been modified by a change
+     *
+     * The k-vectors and their prefactors are copied only if the box changed, the ion structure
+     * factors always, and the cached phase factors only for the changed particles unless everything
+     * changed. Dipolar structure factors are currently unused and not copied.
+     *
+     * @param other Data to copy from
+     * @param change Change made to the system
+     * @param groups Groups of either space; only their positions in the particle vector are used
+     */
+    void sync(const EwaldData &other, const Change &change, const Space::Tgvec &groups);
 };
 
 NLOHMANN_JSON_SERIALIZE_ENUM(EwaldData::Policies, {
@@ -96,6 +119,7 @@ NLOHMANN_JSON_SERIALIZE_ENUM(EwaldData::Policies, {
                                                       {EwaldData::PBCEigen, "PBCEigen"},
                                                       {EwaldData::IPBC, "IPBC"},
                                                       {EwaldData::IPBCEigen, "IPBCEigen"},
+                                                      {EwaldData::PME, "PME"},
                                                   })
 
 void to_json(json &, const EwaldData &);
@@ -118,28 +142,21 @@ class EwaldPolicyBase {
                                  Space::Tgvec &) = 0;       //!< Surface energy contribution due to a change
     virtual double reciprocalEnergy(const EwaldData &) = 0; //!< Total reciprocal energy
 
+    static std::shared_ptr<EwaldPolicyBase> makePolicy(EwaldData::Policies); //!< Policy factory
+
+  protected:
     /**
-     * @brief Represent charges and positions using an Eigen facade (Map)
+     * @brief Decides if a loop over k-vectors shall be spread over OpenMP threads
      *
-     * Requires that all groups are fully active, i.e. does not work for GCMC.
+     * Each k-vector is updated independently, hence only the total amount of work matters. Small updates, e.g.,
+     * due to a single displaced particle, are not worth the threading overhead.
      *
-     * @param groups Vector of groups to represent
-     * @return tuple with positions, charges
+     * @param num_kvectors  number of k-vectors
+     * @param num_particles  number of particles summed for each k-vector
      */
-    auto mapGroupsToEigen(Space::Tgvec &groups) const {
-        for (auto &g : groups)
-            if (g.size() != g.capacity())
-                throw std::runtime_error("Eigen optimized Ewald not available with inactive groups");
-        auto first_particle = groups.front().begin();
-        auto last_particle = groups.back().end();
-        auto pos = asEigenMatrix(first_particle, last_particle,
-                                 &Space::Tparticle::pos); // N x 3
-        auto charge = asEigenVector(first_particle, last_particle,
-                                    &Space::Tparticle::charge); // N x 1
-        return std::make_tuple(pos, charge);
-    }
-
-    static std::shared_ptr<EwaldPolicyBase> makePolicy(EwaldData::Policies); //!< Policy factory
+    static bool parallelOverKvectors(Eigen::Index num_kvectors, size_t num_particles);
+    static size_t countParticles(const Space::Tgvec &groups); //!< Number of active particles in groups
+    static size_t countParticles(const Change &change); //!< Number of explicitly changed particles
 };
 
 /**
@@ -153,18 +170,58 @@ struct PolicyIonIon : public EwaldPolicyBase {
     double selfEnergy(const EwaldData &, Change &, Space::Tgvec &) override;
     double surfaceEnergy(const EwaldData &, Change &, Space::Tgvec &) override;
     double reciprocalEnergy(const EwaldData &) override;
+
+  protected:
+    /**
+     * @brief Per-axis phase factors of the changed particles, for their new and old state
+     *
+     * The old factors are taken from `EwaldData::phase_factors`, which caches them for the accepted state, while the
+     * new ones are evaluated and stored in the cache. Particles with unchanged positions, e.g., after a charge swap,
+     * reuse the cached factors. Inactive particles have zero charge.
+     */
+    struct ChangedPhaseFactors {
+        std::vector<double> new_charges, old_charges; //!< Charges of the changed particles
+        Eigen::MatrixXcd new_factors, old_factors;    //!< Phase factors, one column per changed particle
+    };
+
+    /**
+     * @brief Evaluates the phase factors of all active particles and stores them in `EwaldData::phase_factors`
+     *
+     * Particles are indexed relative to the beginning of the first group, i.e., the particle vector. Inactive
+     * particles get unit factors, which keeps them finite when an inserted particle enters with zero old charge.
+     */
+    static void updatePhaseFactors(EwaldData &, Space::Tgvec &);
+    static void setPhaseFactors(EwaldData &, const Point &position, Eigen::Index particle_index);
+    static ChangedPhaseFactors changedPhaseFactors(EwaldData &, Change &, Space::Tgvec &, Space::Tgvec &);
+
+    /**
+     * @brief Cached phase factors and charges of the active particles only
+     *
+     * Inactive particles, e.g. in grand canonical simulations, are left out so that matrix operations over
+     * particles need no masking.
+     *
+     * @return Phase factors with one row per active particle, and their charges
+     */
+    static std::pair<Eigen::MatrixXcd, Eigen::VectorXd> activePhaseFactors(const EwaldData &, Space::Tgvec &);
+
+    /**
+     * @brief Sums the structure factors of all active particles from their cached phase factors
+     * @param phase  function returning the phase of a k-vector from the phase factors of a particle
+     */
+    template <typename TPhase> static void sumStructureFactors(EwaldData &, Space::Tgvec &, TPhase phase);
+
+    /** @brief Adds the new and subtracts the old contributions of changed particles to the structure factors */
+    template <typename TPhase>
+    static void addChangedStructureFactors(EwaldData &, const ChangedPhaseFactors &, TPhase phase);
 };
 
 /**
  * @brief Ion-Ion Ewald with periodic boundary conditions (PBC) using Eigen
  * operations
- * @warning Will not work with Space with inactive particles (GCMC, for example)
  *
- * For compilers that offer good vectorization (gcc on linux) this brings a 4-5
- * fold speed increase.
- * Status on February, 2020:
- * - Clang9: Eigen version is slower than generic version (macos/ubuntu)
- * - GCC9: Eigen is 4-5 times faster on x86 linux; ~1.5 times *lower on macos.
+ * The structure factors of all k-vectors sharing nx and ny follow from a single
+ * matrix-vector product with the cached phase factors of the particles, which
+ * Eigen vectorizes. The partial update is the same as in `PolicyIonIon`.
  */
 struct PolicyIonIonEigen : public PolicyIonIon {
     void updateComplex(EwaldData &, Space::Tgvec &) const override;
@@ -183,12 +240,30 @@ struct PolicyIonIonIPBC : public PolicyIonIon {
 
 /**
  * @brief Ion-Ion Ewald with isotropic periodic boundary conditions (IPBC) using Eigen operations
- * @warning Incomplete and under construction
+ *
+ * The full update uses matrix-vector products as `PolicyIonIonEigen`; the partial update is that of
+ * `PolicyIonIonIPBC`.
  */
 struct PolicyIonIonIPBCEigen : public PolicyIonIonIPBC {
     void updateComplex(EwaldData &, Space::Tgvec &) const override;
 };
 
+/**
+ * @brief Ion-Ion smooth particle-mesh Ewald (PME) using periodic boundary conditions
+ *
+ * Charges are spread onto a mesh by cardinal B-splines and the structure factors are obtained by a single fast
+ * Fourier transform of the mesh, i.e., in O(N + M log M) instead of O(N x K) operations. The k-vectors, and hence
+ * the truncation of the reciprocal sum, are the same as for `PolicyIonIon`, whereas the B-spline moduli are absorbed
+ * into `EwaldData::Aks`. The partial update spreads only the changed charges and adds the Fourier transforms of
+ * their stencils directly to the structure factors. It requires neither the mesh nor trigonometric functions.
+ */
+struct PolicyIonIonPME : public PolicyIonIon {
+    PolicyIonIonPME();
+    void updateBox(EwaldData &, const Point &) const override;
+    void updateComplex(EwaldData &, Space::Tgvec &) const override;
+    void updateComplex(EwaldData &, Change &, Space::Tgvec &, Space::Tgvec &) const override;
+};
+
 /** @brief Ewald summation reciprocal energy */
 class Ewald : public Energybase {
   private:
@@ -207,6 +282,34 @@ class Ewald : public Energybase {
     void to_json(json &) const override;
 };
 
+/**
+ * @brief Ewald parameters meeting an absolute energy tolerance at minimum cost
+ *
+ * For each trial real-space cutoff, the splitting parameter and the smallest reciprocal-space cutoff
+ * are chosen so that the Kolafa-Perram error estimates (doi:10.1080/08927029208049126) of both parts
+ * equal the tolerance divided by √2. The cost of each candidate is then measured on the actual
+ * configuration: the real-space part as the timed pair kernel times the number of pairs within
+ * the cutoff, and the reciprocal-space part by timing a full k-space update of the configured policy.
+ * The candidate with the shortest total time is returned.
+ *
+ * @param j Ewald input with `tolerance` (kT); a given `cutoff` is kept fixed
+ * @param spc Space with the system to probe
+ * @return Input with `alpha`, `cutoff`, `ncutoff`, and a summary under `autotune` instead of `tolerance`
+ */
+json tuneEwald(const json &j, Space &spc);
+
+/**
+ * @brief Energy input where each Ewald `coulomb` with a `tolerance` is replaced by tuned parameters
+ *
+ * The real-space pair potential and the reciprocal-space term hence see the same splitting parameter and
+ * cutoffs. As the choice depends on timings, Hamiltonians that shall be identical, e.g. of the accepted and
+ * the trial state, must be constructed from the same tuned input. Tuning the result again leaves it unchanged.
+ *
+ * @param energy Energy list as given to the Hamiltonian
+ * @param spc Space with the system to probe
+ */
+json tuneEwaldInput(const json &energy, Space &spc);
+
 class Isobaric : public Energybase {
   private:
     Space &spc;
@@ -241,18 +344,64 @@ class Constrain : public Energybase {
  *
  * @todo Optimize.
  */
+/**
+ * @brief Bonds that each particle takes part in, stored in compressed sparse row (CSR) format
+ *
+ * Finds the bonds touching a set of particles without scanning all bonds. A visit stamp per bond
+ * ensures that a bond touching several of the particles is visited only once.
+ */
+class BondIncidence {
+    int first_particle = 0;            //!< Absolute index of the first indexed particle
+    std::vector<int> offsets;          //!< Bonds of particle `i` start at `bond_indices[offsets[i - first_particle]]`
+    std::vector<int> bond_indices;     //!< Bond indices ordered by particle
+    std::vector<unsigned int> stamps;  //!< Stamp of the last visit to each bond
+    unsigned int current_stamp = 0;
+
+  public:
+    BondIncidence() = default;
+    BondIncidence(const BasePointerVector<Potential::BondData> &bonds, int first_particle, int num_particles);
+    bool anyBonds(int first, int last) const; //!< True if any particle in [first, last) takes part in a bond
+
+    /**
+     * @brief Calls `function` with the index of each bond touching at least one of the particles, once per bond
+     * @param particles Absolute particle indices; particles outside the indexed range have no bonds
+     */
+    template <typename Tfunction> void forEachBond(const std::vector<int> &particles, Tfunction function) {
+        if (++current_stamp == 0) { // wrapped around
+            std::fill(stamps.begin(), stamps.end(), 0);
+            current_stamp = 1;
+        }
+        for (auto particle : particles) {
+            const int i = particle - first_particle;
+            if (i < 0 || i + 1 >= static_cast<int>(offsets.size()))
+                continue;
+            for (int k = offsets[i]; k < offsets[i + 1]; k++) {
+                const int bond = bond_indices[k];
+                if (stamps[bond] != current_stamp) {
+                    stamps[bond] = current_stamp;
+                    function(bond);
+                }
+            }
+        }
+    }
+};
+
 class Bonded : public Energybase {
   private:
     Space &spc;
     typedef BasePointerVector<Potential::BondData> BondVector;
     BondVector inter;                // inter-molecular bonds
     std::map<int, BondVector> intra; // intra-molecular bonds
+    Potential::CompiledBonds inter_compiled;                // `inter`, compiled for evaluation
+    std::map<int, Potential::CompiledBonds> intra_compiled; // `intra`, compiled for evaluation
+    std::map<int, BondIncidence> intra_incidence;           // bonds of each particle in `intra`
+    BondIncidence inter_incidence;                          // bonds of each particle in `inter`
 
   private:
-    void update_intra();                              // finds and adds all intra-molecular bonds of active molecules
-    double sum_energy(const BondVector &) const;      // sum energy in vector of BondData
-    double sum_energy(const BondVector &,
-                      const std::vector<int> &) const; // sum energy in vector of BondData for matching particle indices
+    void update_intra(); // finds and adds all intra-molecular bonds of active molecules
+    double sum_energy(const Potential::CompiledBonds &) const; // sum energy of compiled bonds
+    double sum_energy(const Potential::CompiledBonds &, BondIncidence &,
+                      const std::vector<int> &) const; // sum energy of compiled bonds for matching particle indices
 
   public:
     Bonded(const json &, Space &);
@@ -287,9 +436,8 @@ template <typename TSize, typename TSet> inline auto indexComplement(const TSize
  */
 class GroupCutoff {
     double default_cutoff_squared = pc::max_value;
-    PairMatrix<double> cutoff_squared;  //!< matrix with group-to-group cutoff distances squared in angstrom squared
-    double total_cnt = 0, skip_cnt = 0; //!< statistics
-    Space::Tgeometry &geometry;         //!< geometry to compute the inter group distance with
+    PairMatrix<double> cutoff_squared; //!< matrix with group-to-group cutoff distances squared in angstrom squared
+    Space::Tgeometry &geometry;        //!< geometry to compute the inter group distance with
     friend void from_json(const json&, GroupCutoff &);
     friend void to_json(json&, const GroupCutoff &);
 
@@ -297,23 +445,23 @@ class GroupCutoff {
     /**
      * @brief Determines if two groups are separated beyond the cutoff distance.
      * @return true if the group-to-group distance is beyond the cutoff distance, false otherwise
+     * @note Thread-safe as no state is modified
      */
-    template <typename TGroup> inline bool cut(const TGroup &group1, const TGroup &group2) {
-        bool result = false;
-        ++total_cnt;
-        if (!group1.atomic && !group2.atomic // atomic groups have no meaningful cm
-            && geometry.sqdist(group1.cm, group2.cm) >= cutoff_squared(group1.id, group2.id)) {
-            result = true;
-            ++skip_cnt;
-        }
-        return result;
+    template <typename TGroup> inline bool cut(const TGroup &group1, const TGroup &group2) const {
+        return !group1.atomic && !group2.atomic // atomic groups have no meaningful cm
+               && geometry.sqdist(group1.cm, group2.cm) >= cutoff_squared(group1.id, group2.id);
     }
 
     /**
      * @brief A functor alias for cut().
      * @see cut()
      */
-    template <typename... Args> inline auto operator()(Args &&... args) { return cut(std::forward<Args>(args)...); }
+    template <typename... Args> inline auto operator()(Args &&... args) const {
+        return cut(std::forward<Args>(args)...);
+    }
+
+    //! Largest cutoff distance of all group pairs; infinite if any pair is never cut
+    double maxCutoff() const;
 
     /**
      * @brief Sets the geometry.
@@ -325,6 +473,17 @@ class GroupCutoff {
 void from_json(const json&, GroupCutoff &);
 void to_json(json&, const GroupCutoff &);
 
+/**
+ * @brief True if the pair potential provides `isotropicEnergy(id1, charge1, id2, charge2, r2)`.
+ *
+ * Such a pair potential depends only on the atom ids, charges, and the squared distance. Hence it can be
+ * evaluated in vectorizable loops over the structure-of-arrays particle data, see ParticleArrays.
+ */
+template <class T, class = void> struct has_isotropic_energy : std::false_type {};
+template <class T>
+struct has_isotropic_energy<T, std::void_t<decltype(std::declval<const T &>().isotropicEnergy(0, 0.0, 0, 0.0, 0.0))>>
+    : std::true_type {};
+
 /**
  * @brief Provides a fast inlineable interface for non-bonded pair potential energy computation.
  *
@@ -337,6 +496,10 @@ template <typename TPairPotential, bool allow_anisotropic_pair_potential = true>
     Space &spc;                                //!< space to init ParticleSelfEnergy with @see addPairPotentialSelfEnergy
     BasePointerVector<Energybase> &potentials; //!< registered non-bonded potentials @see addPairPotentialSelfEnergy
   public:
+    //! True if the pair energy can be summed over ParticleArrays by the vectorizable kernel
+    static constexpr bool vectorizable =
+        !allow_anisotropic_pair_potential && has_isotropic_energy<TPairPotential>::value;
+
     /**
      * @param spc
      * @param potentials  registered non-bonded potentials
@@ -360,6 +523,115 @@ template <typename TPairPotential, bool allow_anisotropic_pair_potential = true>
         }
     }
 
+    /**
+     * @brief Computes the sum of pair potential energies between a particle and a range of particles.
+     *
+     * A 1-vs-many kernel streaming over the structure-of-arrays mirror. Squared distances and pair energies
+     * are computed in chunks by loops that the compiler can vectorize for the target instruction set.
+     * Only available if `vectorizable`.
+     *
+     * @param a  particle
+     * @param arrays  structure-of-arrays particle data
+     * @param first  index of the first particle in the arrays
+     * @param last  index past the last particle in the arrays; particle `a` shall not be within the range
+     * @return pair potential energy sum
+     */
+    inline double potential(const Particle &a, const ParticleArrays &arrays, size_t first, size_t last) const {
+        constexpr size_t chunk_size = 64;
+        std::array<double, chunk_size> squared_distances;
+        double u = 0;
+        for (size_t chunk = first; chunk < last; chunk += chunk_size) {
+            const size_t size = std::min(chunk_size, last - chunk);
+            geometry.sqdist(a.pos, &arrays.x[chunk], &arrays.y[chunk], &arrays.z[chunk], squared_distances.data(),
+                            size);
+            const int *id = &arrays.id[chunk];
+            const double *charge = &arrays.charge[chunk];
+#pragma omp simd reduction(+ : u)
+            for (size_t i = 0; i < size; ++i) {
+                u += pair_potential.isotropicEnergy(a.id, a.charge, id[i], charge[i], squared_distances[i]);
+            }
+        }
+        return u;
+    }
+
+    /**
+     * @brief Computes pair potential energies between a particle and each particle in a range of particles.
+     *
+     * The same kernel as above, yet the individual pair energies are stored instead of summed up.
+     * Only available if `vectorizable`.
+     *
+     * @param a  particle
+     * @param arrays  structure-of-arrays particle data
+     * @param first  index of the first particle in the arrays
+     * @param last  index past the last particle in the arrays
+     * @param energies  output of the size `last - first`; the energy with `a` itself is undefined if in the range
+     */
+    inline void potentialEach(const Particle &a, const ParticleArrays &arrays, size_t first, size_t last,
+                              double *energies) const {
+        constexpr size_t chunk_size = 64;
+        std::array<double, chunk_size> squared_distances;
+        for (size_t chunk = first; chunk < last; chunk += chunk_size) {
+            const size_t size = std::min(chunk_size, last - chunk);
+            geometry.sqdist(a.pos, &arrays.x[chunk], &arrays.y[chunk], &arrays.z[chunk], squared_distances.data(),
+                            size);
+            const int *id = &arrays.id[chunk];
+            const double *charge = &arrays.charge[chunk];
+            double *energy = &energies[chunk - first];
+#pragma omp simd
+            for (size_t i = 0; i < size; ++i) {
+                energy[i] = pair_potential.isotropicEnergy(a.id, a.charge, id[i], charge[i], squared_distances[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Computes the pair potential energy change of a displaced particle with a range of particles.
+     *
+     * The same kernel as above, yet both the new and the old particle are paired with each particle
+     * in the range in a single sweep over the arrays. Only available if `vectorizable`.
+     *
+     * @param a  particle in the new state
+     * @param a_old  the same particle in the old state
+     * @param arrays  structure-of-arrays particle data
+     * @param first  index of the first particle in the arrays
+     * @param last  index past the last particle in the arrays; particle `a` shall not be within the range
+     * @return pair potential energy sum of the new state minus the sum of the old state
+     */
+    inline double potentialChange(const Particle &a, const Particle &a_old, const ParticleArrays &arrays,
+                                  size_t first, size_t last) const {
+        constexpr size_t chunk_size = 64;
+        std::array<double, chunk_size> squared_distances, squared_distances_old;
+        double du = 0;
+        for (size_t chunk = first; chunk < last; chunk += chunk_size) {
+            const size_t size = std::min(chunk_size, last - chunk);
+            geometry.sqdist(a.pos, &arrays.x[chunk], &arrays.y[chunk], &arrays.z[chunk], squared_distances.data(),
+                            size);
+            geometry.sqdist(a_old.pos, &arrays.x[chunk], &arrays.y[chunk], &arrays.z[chunk],
+                            squared_distances_old.data(), size);
+            const int *id = &arrays.id[chunk];
+            const double *charge = &arrays.charge[chunk];
+#pragma omp simd reduction(+ : du)
+            for (size_t i = 0; i < size; ++i) {
+                du += pair_potential.isotropicEnergy(a.id, a.charge, id[i], charge[i], squared_distances[i]) -
+                      pair_potential.isotropicEnergy(a_old.id, a_old.charge, id[i], charge[i],
+                                                     squared_distances_old[i]);
+            }
+        }
+        return du;
+    }
+
+    /**
+     * @brief Computes pair potential energy at a given distance vector, regardless of the particle positions.
+     *
+     * @param a  particle
+     * @param b  particle
+     * @param r  distance vector between the particles
+     * @return pair potential energy between particles a and b
+     */
+    template <typename T> inline double potential(const T &a, const T &b, const Point &r) const {
+        return pair_potential(a, b, r.squaredNorm(), r);
+    }
+
     // just a temporary placement until PairForce class template will be implemented
     template <typename T> inline Point force(const T &a, const T &b) const {
         assert(&a != &b); // a and b cannot be the same particle
@@ -419,13 +691,167 @@ template <typename TPairEnergy, typename TCutoff> class PairingBasePolicy {
     TPairEnergy pair_energy; //!< a functor to compute non-bonded energy between two particles @see PairEnergy
     GroupCutoff cut;         //!< a cutoff functor that determines if energy between two groups can be ignored
 
+    //! Absolute index of a particle in the space
+    size_t particleIndex(const Particle &particle) const { return &particle - spc.p.data(); }
+
+    //! Index of a group in the space
+    template <typename TGroup> int groupIndex(const TGroup &group) const { return &group - spc.groups.data(); }
+
+    /**
+     * @brief Pairing between a particle and particles in the absolute index range [first, last) of the space.
+     *
+     * The vectorizable kernel streaming over the structure-of-arrays mirror of the space is used if available.
+     */
+    inline double particle2range(const Particle &particle, size_t first, size_t last) const {
+        double u = 0;
+        if constexpr (TPairEnergy::vectorizable) {
+            u = pair_energy.potential(particle, spc.getParticleArrays(), first, last);
+        } else {
+            for (size_t i = first; i < last; ++i) {
+                u += particle2particle(particle, spc.p[i]);
+            }
+        }
+        return u;
+    }
+
+    //! Pairing between a particle and all active particles in a group; the vectorizable kernel is used if available
+    template <typename TGroup> inline double particle2group(const Particle &particle, const TGroup &group) const {
+        const size_t first = std::distance(spc.p.begin(), group.begin());
+        return particle2range(particle, first, first + group.size());
+    }
+
+    /**
+     * @brief Throws unless the pair energy vanishes beyond the given distance for all pairs of atom types.
+     *
+     * Pairing schemes which skip distant particles in some, but not all, summations use it to make sure that all
+     * summations see the same Hamiltonian. Unit charges are probed at distances from the cutoff up to half the box
+     * diagonal, i.e., the largest minimum image distance in a cuboid.
+     *
+     * @param cutoff  distance beyond which the pair energy shall be zero
+     * @param name  name of the pairing scheme for the error message
+     */
+    void requireVanishingPairEnergy(double cutoff, const std::string &name) const {
+        constexpr int number_of_probes = 100;
+        const double max_distance = std::max(cutoff, 0.5 * spc.geo.getLength().norm());
+        const Point direction = Point::Ones().normalized();
+        for (size_t i = 0; i < Faunus::atoms.size(); ++i) {
+            for (size_t j = i; j < Faunus::atoms.size(); ++j) {
+                Particle a(Faunus::atoms[i]), b(Faunus::atoms[j]);
+                a.charge = b.charge = 1.0;
+                for (int probe = 0; probe <= number_of_probes; ++probe) {
+                    const double distance =
+                        std::nextafter(cutoff + (max_distance - cutoff) * probe / number_of_probes, pc::infty);
+                    if (pair_energy.potential(a, b, Point(direction * distance)) != 0.0) {
+                        throw std::runtime_error(name + ": the pair energy between " + Faunus::atoms[i].name +
+                                                 " and " + Faunus::atoms[j].name + " does not vanish beyond " +
+                                                 std::to_string(cutoff));
+                    }
+                }
+            }
+        }
+    }
+
+    //! True if the precomputed intramolecular partner ranges of the molecule match the group
+    template <typename TGroup> static bool hasPartnerRanges(const TGroup &group) {
+        return group.traits().partnerRanges().size() == static_cast<int>(group.capacity());
+    }
+
+    /**
+     * @brief Pairing between a particle in a molecular group and its active, non-excluded partners in the group.
+     *
+     * The partners are streamed range by range from the precomputed partner ranges of the molecule.
+     *
+     * @param group
+     * @param index  internal index of the particle within the group
+     * @param forward_only  pair only with partners of a larger index, i.e., sum each pair of the group once
+     * @see PartnerRanges
+     */
+    template <typename TGroup>
+    double particle2partners(const TGroup &group, const int index, const bool forward_only = false) const {
+        double u = 0;
+        const auto &partner_ranges = group.traits().partnerRanges();
+        const size_t first = std::distance(spc.p.begin(), group.begin());
+        const int group_size = group.size();
+        const auto *range = forward_only ? partner_ranges.forward(index) : partner_ranges.begin(index);
+        for (; range != partner_ranges.end(index); ++range) {
+            const int last = std::min(range->second, group_size);
+            if (range->first < last) {
+                u += particle2range(group[index], first + range->first, first + last);
+            }
+        }
+        return u;
+    }
+
+    /**
+     * @brief Energy change of a particle displaced from `old_particle` paired with particles in the absolute index
+     * range [first, last) of the space; the vectorizable kernel is used if available.
+     *
+     * @param particle  particle in the new state
+     * @param old_particle  the same particle in the old state
+     */
+    inline double particle2rangeChange(const Particle &particle, const Particle &old_particle, size_t first,
+                                       size_t last) const {
+        double du = 0;
+        if constexpr (TPairEnergy::vectorizable) {
+            du = pair_energy.potentialChange(particle, old_particle, spc.getParticleArrays(), first, last);
+        } else {
+            for (size_t i = first; i < last; ++i) {
+                du += particle2particle(particle, spc.p[i]) - particle2particle(old_particle, spc.p[i]);
+            }
+        }
+        return du;
+    }
+
+    /**
+     * @brief Energy change of displaced particles in a group paired with the static particles of another group.
+     *
+     * The group cutoff is evaluated for both the new and the old position of the group. Only if both are within
+     * the cutoff, the new and the old pairs are summed in a single sweep by the `range_change` functor.
+     *
+     * @param group  group in the new state
+     * @param old_group  the same group in the old state
+     * @param other_group  static group
+     * @param index  list of displaced particle indices in the group relative to the group beginning
+     * @param range_change  functor computing the energy change of a displaced particle with a range of particles
+     * @return energy change
+     * @see particle2rangeChange
+     */
+    template <typename TGroup, typename TRangeChange>
+    double group2groupChange(const TGroup &group, const TGroup &old_group, const TGroup &other_group,
+                             const std::vector<int> &index, TRangeChange &&range_change) {
+        double du = 0;
+        const bool is_cut = cut(other_group, group);
+        const bool is_old_cut = cut(other_group, old_group);
+        const size_t first = std::distance(spc.p.begin(), other_group.begin());
+        const size_t last = first + other_group.size();
+        for (const int i : index) {
+            if (!is_cut && !is_old_cut) {
+                du += range_change(group[i], old_group[i], first, last);
+            } else {
+                if (!is_cut) {
+                    du += particle2range(group[i], first, last);
+                }
+                if (!is_old_cut) {
+                    du -= particle2range(old_group[i], first, last);
+                }
+            }
+        }
+        return du;
+    }
+
   public:
+    static constexpr bool single_pass_change = true; //!< energy changes can be summed in a single sweep @see group2allChange
+
     /**
      * @param spc
      * @param potentials  registered non-bonded potentials
      */
     PairingBasePolicy(Space &spc, BasePointerVector<Energybase> &potentials)
-        : spc(spc), pair_energy(spc, potentials), cut(spc.geo) {}
+        : spc(spc), pair_energy(spc, potentials), cut(spc.geo) {
+        if constexpr (TPairEnergy::vectorizable) {
+            spc.enableParticleArrays();
+        }
+    }
 
     void from_json(const json &j) {
         Energy::from_json(j, cut);
@@ -437,10 +863,48 @@ template <typename TPairEnergy, typename TCutoff> class PairingBasePolicy {
         Energy::to_json(j, cut);
     }
 
+    void init() {} //!< Initializes auxiliary data, e.g., neighbour lists; nothing to do here
+
+    /**
+     * @brief Updates auxiliary data, e.g., neighbour lists, to reflect the changed particles in the space
+     *
+     * Called before the energy evaluation and on sync. Only the structure-of-arrays mirror of the space
+     * is refreshed here if used by the pair energy kernel.
+     */
+    void update(const Change &change) {
+        if constexpr (TPairEnergy::vectorizable) {
+            spc.updateParticleArrays(change);
+        }
+    }
+
     template <typename T> inline double particle2particle(const T &a, const T &b) const {
         return pair_energy.potential(a, b);
     }
 
+    /**
+     * @brief Pair energies between a particle and each particle in the absolute index range [first, last) of
+     * the space; the vectorizable kernel is used if available.
+     *
+     * @param particle
+     * @param first
+     * @param last
+     * @param energies  output of the size `last - first`; the energy with the particle itself is undefined
+     */
+    inline void particle2rangeEach(const Particle &particle, size_t first, size_t last, double *energies) const {
+        if constexpr (TPairEnergy::vectorizable) {
+            pair_energy.potentialEach(particle, spc.getParticleArrays(), first, last, energies);
+        } else {
+            for (size_t i = first; i < last; ++i) {
+                energies[i - first] = (&particle != &spc.p[i]) ? particle2particle(particle, spc.p[i]) : 0.0;
+            }
+        }
+    }
+
+    //! True if the pairing between two groups is skipped due to the group cutoff
+    template <typename TGroup> inline bool isCut(const TGroup &group1, const TGroup &group2) const {
+        return cut(group1, group2);
+    }
+
     /**
      * @brief Internal energy of a group.
      *
@@ -455,12 +919,21 @@ template <typename TPairEnergy, typename TCutoff> class PairingBasePolicy {
         auto &moldata = group.traits();
         if (!moldata.rigid) {
             const int group_size = group.size();
-            for (int i = 0; i < group_size - 1; ++i) {
-                for (int j = i + 1; j < group_size; ++j) {
-                    // This compound condition is faster than an outer atomic condition;
-                    // tested on bulk example in GCC 9.2.
-                    if (group.atomic || !moldata.isPairExcluded(i, j)) {
-                        u += particle2particle(group[i], group[j]);
+            if (group.atomic) {
+                const size_t first = std::distance(spc.p.begin(), group.begin());
+                for (int i = 0; i < group_size - 1; ++i) {
+                    u += particle2range(group[i], first + i + 1, first + group_size);
+                }
+            } else if (hasPartnerRanges(group)) {
+                for (int i = 0; i < group_size - 1; ++i) {
+                    u += particle2partners(group, i, true);
+                }
+            } else {
+                for (int i = 0; i < group_size - 1; ++i) {
+                    for (int j = i + 1; j < group_size; ++j) {
+                        if (!moldata.isPairExcluded(i, j)) {
+                            u += particle2particle(group[i], group[j]);
+                        }
                     }
                 }
             }
@@ -483,12 +956,11 @@ template <typename TPairEnergy, typename TCutoff> class PairingBasePolicy {
         if (!moldata.rigid) {
             if (group.atomic) {
                 // speed optimization: non-bonded interaction exclusions do not need to be checked for atomic groups
-                for (int i = 0; i < index; ++i) {
-                    u += particle2particle(group[index], group[i]);
-                }
-                for (int i = index + 1; i < group.size(); ++i) {
-                    u += particle2particle(group[index], group[i]);
-                }
+                const size_t first = std::distance(spc.p.begin(), group.begin());
+                u = particle2range(group[index], first, first + index) +
+                    particle2range(group[index], first + index + 1, first + group.size());
+            } else if (hasPartnerRanges(group)) {
+                u = particle2partners(group, index);
             } else {
                 // molecular group
                 for (int i = 0; i < index; ++i) {
@@ -522,6 +994,26 @@ template <typename TPairEnergy, typename TCutoff> class PairingBasePolicy {
         if (!moldata.rigid) {
             if (index.size() == 1) {
                 u = groupInternal(group, index[0]);
+            } else if (!group.atomic && hasPartnerRanges(group)) {
+                // pairs of two moved particles are summed only once, from the particle with the smaller index
+                const int group_size = group.size();
+                std::vector<unsigned char> is_moved(group_size, false);
+                for (int i : index) {
+                    if (i < group_size) {
+                        is_moved[i] = true;
+                    }
+                }
+                const auto &partner_ranges = moldata.partnerRanges();
+                for (int i : index) {
+                    for (auto range = partner_ranges.begin(i); range != partner_ranges.end(i); ++range) {
+                        const int last = std::min(range->second, group_size);
+                        for (int j = range->first; j < last; ++j) {
+                            if (!is_moved[j] || j > i) {
+                                u += particle2particle(group[i], group[j]);
+                            }
+                        }
+                    }
+                }
             } else {
                 // TODO investigate overhead of `index_complement` filtering;
                 // TODO perhaps allow different strategies based on the index-size/group-size ratio
@@ -713,6 +1205,9 @@ template <typename TPairEnergy, typename TCutoff> class PairingBasePolicy {
         for (auto &other_group : spc.groups) {
             if (&other_group != &group) {
                 u += group2group(group, other_group);
+                if (u == pc::infty) {
+                    break; // an overlap cannot be compensated; the move will be rejected anyway
+                }
             }
         }
         return u;
@@ -734,10 +1229,11 @@ template <typename TPairEnergy, typename TCutoff> class PairingBasePolicy {
         double u = 0;
         const auto &particle = group[index];
         for (auto &other_group : spc.groups) {
-            if (&other_group != &group) {                      // avoid self-interaction
-                if (!cut(other_group, group)) {                // check g2g cut-off
-                    for (auto &other_particle : other_group) { // loop over particles in other group
-                        u += particle2particle(particle, other_particle);
+            if (&other_group != &group) {                       // avoid self-interaction
+                if (!cut(other_group, group)) {                 // check g2g cut-off
+                    u += particle2group(particle, other_group); // loop over particles in other group
+                    if (u == pc::infty) {
+                        break; // an overlap cannot be compensated
                     }
                 }
             }
@@ -765,12 +1261,81 @@ template <typename TPairEnergy, typename TCutoff> class PairingBasePolicy {
             for (auto &other_group : spc.groups) {
                 if (&other_group != &group) {
                     u += group2group(group, other_group, index);
+                    if (u == pc::infty) {
+                        break; // an overlap cannot be compensated
+                    }
                 }
             }
         }
         return u;
     }
 
+    /**
+     * @brief Energy change, `u_new - u_old`, due to displaced particles in a group paired with particles in other
+     * groups in space.
+     *
+     * Instead of two complete pairings of the new and the old state, each displaced particle is paired in both its
+     * new and old position with the static particles in a single sweep. The static particles are the same in both
+     * states, hence they are taken from this space, while the old positions are taken from the old group. The number
+     * of particles shall not change.
+     *
+     * @param group  group in the new state, i.e., in this space
+     * @param old_group  the same group in the old state
+     * @param index  list of displaced particle indices in the group relative to the group beginning
+     * @return energy change
+     */
+    template <typename TGroup>
+    double group2allChange(const TGroup &group, const TGroup &old_group, const std::vector<int> &index) {
+        double du = 0;
+        auto range_change = [&](const Particle &particle, const Particle &old_particle, size_t first, size_t last) {
+            return particle2rangeChange(particle, old_particle, first, last);
+        };
+        for (auto &other_group : spc.groups) {
+            if (&other_group != &group) {
+                du += group2groupChange(group, old_group, other_group, index, range_change);
+                if (du == pc::infty) {
+                    break; // an overlap cannot be compensated
+                }
+            }
+        }
+        return du;
+    }
+
+    /**
+     * @brief Energy change, `u_new - u_old`, due to displaced particles in a group paired with particles of another
+     * group.
+     * @see group2allChange
+     */
+    template <typename TGroup>
+    double group2groupChange(const TGroup &group, const TGroup &old_group, const TGroup &other_group,
+                             const std::vector<int> &index) {
+        return group2groupChange(group, old_group, other_group, index,
+                                 [&](const Particle &particle, const Particle &old_particle, size_t first,
+                                     size_t last) { return particle2rangeChange(particle, old_particle, first, last); });
+    }
+
+    /**
+     * @brief Internal energy change of an atomic group due to a single displaced particle, summed in a single sweep.
+     *
+     * No pair exclusions exist in atomic groups.
+     *
+     * @param group  atomic group in the new state
+     * @param old_group  the same group in the old state
+     * @param index  internal index of the displaced particle within the group
+     * @return energy change
+     * @see group2allChange
+     */
+    template <typename TGroup> double groupInternalChange(const TGroup &group, const TGroup &old_group, const int index) {
+        assert(group.atomic);
+        double du = 0;
+        if (!group.traits().rigid) {
+            const size_t first = std::distance(spc.p.begin(), group.begin());
+            du = particle2rangeChange(group[index], old_group[index], first, first + index) +
+                 particle2rangeChange(group[index], old_group[index], first + index + 1, first + group.size());
+        }
+        return du;
+    }
+
     /**
      * @brief Cross pairing of particles among a union of groups. No internal pairs within any group are considered.
      *
@@ -874,35 +1439,974 @@ class PairingPolicy : public PairingBasePolicy<TPairEnergy, TCutoff> {
 };
 
 /**
- * @brief Computes change in the non-bonded energy, assuming pair-wise additive energy terms.
+ * @brief OpenMP parallel particle pairing.
  *
- * @tparam TPairingPolicy  pairing policy to effectively sum up the pair-wise additive non-bonded energy
+ * The outer loops over groups or particles are split across threads. Loop items are summed in blocks of a fixed
+ * size and the block sums are reduced serially in the loop order. The energy is hence independent of the number
+ * of threads and of the scheduling. If there are many groups in the space, the loops over groups are split;
+ * otherwise the loops over particles are split as few, large (typically atomic) groups are expected. Without OpenMP
+ * the pragmas are ignored and the policy falls back to a serial summation.
+ *
+ * @warning The pair potential has to be thread-safe, i.e., its `operator()` shall not modify any shared data.
+ * @see PairingBasePolicy
  */
-template <typename TPairingPolicy> class Nonbonded : public Energybase {
-  protected:
-    Space &spc;             //!< space to operate on
-    TPairingPolicy pairing; //!< pairing policy to effectively sum up the pair-wise additive non-bonded energy
+template <typename TPairEnergy, typename TCutoff>
+class PairingPolicy<TPairEnergy, TCutoff, true> : public PairingBasePolicy<TPairEnergy, TCutoff> {
+    typedef PairingBasePolicy<TPairEnergy, TCutoff> base;
+    using base::cut;
+    using base::particle2group;
+    using base::particle2particle;
+    using base::particle2range;
+    using base::particle2rangeChange;
+    using base::spc;
+    static constexpr int particle_block_size = 256;   //!< number of particles summed serially in a block
+    static constexpr size_t min_parallel_groups = 64; //!< minimum number of groups to split loops over groups
+    std::vector<double> block_energies;               //!< scratch storage for partial block sums
 
     /**
-     * @brief Computes non-bonded energy contribution if only a single group has changed.
+     * @brief Deterministic parallel sum of func(i) for i in [0, size)
      *
-     * @param change
-     * @return energy sum between particle pairs
+     * The calls must not be nested as the scratch storage is shared.
+     *
+     * @param size  number of items
+     * @param block_size  number of consecutive items summed serially
+     * @param func  functor returning the energy of the i-th item
+     * @return energy sum
      */
-    double energyGroup(Change &change) {
-        double u = 0;
-        const auto &change_data = change.groups[0];
-        const auto &group = spc.groups.at(change_data.index);
-        if (change_data.atoms.size() == 1) {
-            // faster algorithm if only a single particle moves
-            u = pairing.group2all(group, change_data.atoms[0]);
-            if (change_data.internal) {
-                u += pairing.groupInternal(group, change_data.atoms[0]);
+    template <typename TFunc> double blockSum(const int size, const int block_size, TFunc &&func) {
+        const int num_blocks = (size + block_size - 1) / block_size;
+        block_energies.assign(std::max(num_blocks, 0), 0.0);
+#pragma omp parallel for schedule(dynamic) if (num_blocks > 1)
+        for (int block = 0; block < num_blocks; ++block) {
+            const int last = std::min(size, (block + 1) * block_size);
+            double u = 0;
+            for (int i = block * block_size; i < last; ++i) {
+                u += func(i);
             }
-        } else {
-            const bool change_all = change_data.atoms.empty(); // all particles or only their subset?
-            u = change_all ? pairing.group2all(group) : pairing.group2all(group, change_data.atoms);
-            if (change_data.internal) {
+            block_energies[block] = u;
+        }
+        return std::accumulate(block_energies.begin(), block_energies.end(), 0.0);
+    }
+
+    /**
+     * @brief Pairing between a particle and particles in the absolute index range [first, last) of the space;
+     * blocks of the range are split among threads.
+     * @see PairingBasePolicy::particle2range
+     */
+    double particle2rangeParallel(const Particle &particle, const size_t first, const size_t last) {
+        const int size = last - first;
+        return blockSum((size + particle_block_size - 1) / particle_block_size, 1, [&](const int block) {
+            const int block_first = block * particle_block_size;
+            return particle2range(particle, first + block_first,
+                                  first + std::min(size, block_first + particle_block_size));
+        });
+    }
+
+    /**
+     * @brief Energy change of a displaced particle paired with particles in the absolute index range [first, last)
+     * of the space; blocks of the range are split among threads.
+     * @see PairingBasePolicy::particle2rangeChange
+     */
+    double particle2rangeChangeParallel(const Particle &particle, const Particle &old_particle, const size_t first,
+                                        const size_t last) {
+        const int size = last - first;
+        return blockSum((size + particle_block_size - 1) / particle_block_size, 1, [&](const int block) {
+            const int block_first = block * particle_block_size;
+            return particle2rangeChange(particle, old_particle, first + block_first,
+                                        first + std::min(size, block_first + particle_block_size));
+        });
+    }
+
+    //! True if the loops over groups shall be split among threads rather than loops over particles
+    inline bool splitGroups() const { return spc.groups.size() >= min_parallel_groups; }
+
+    /**
+     * @brief Cartesian pairing of two groups with particles of the first group split among threads.
+     * @see PairingBasePolicy::group2group
+     */
+    template <typename TGroup> double group2groupParallel(const TGroup &group1, const TGroup &group2) {
+        double u = 0;
+        if (!cut(group1, group2)) {
+            u = blockSum(group1.size(), particle_block_size, [&](const int i) {
+                double u_i = 0;
+                for (auto &particle2 : group2) {
+                    u_i += particle2particle(group1[i], particle2);
+                }
+                return u_i;
+            });
+        }
+        return u;
+    }
+
+  public:
+    using base::base;
+
+    /**
+     * @brief Internal energy of a group; particle rows are split among threads.
+     * @see PairingBasePolicy::groupInternal
+     */
+    template <typename TGroup> double groupInternal(const TGroup &group) {
+        double u = 0;
+        auto &moldata = group.traits();
+        if (!moldata.rigid) {
+            const int group_size = group.size();
+            const bool has_partner_ranges = !group.atomic && base::hasPartnerRanges(group);
+            u = blockSum(group_size - 1, particle_block_size, [&](const int i) {
+                if (has_partner_ranges) {
+                    return base::particle2partners(group, i, true);
+                }
+                double u_i = 0;
+                for (int j = i + 1; j < group_size; ++j) {
+                    if (group.atomic || !moldata.isPairExcluded(i, j)) {
+                        u_i += particle2particle(group[i], group[j]);
+                    }
+                }
+                return u_i;
+            });
+        }
+        return u;
+    }
+
+    /**
+     * @brief Partial internal energy of a single particle within a group; the group particles are split among threads.
+     * @see PairingBasePolicy::groupInternal
+     */
+    template <typename TGroup> double groupInternal(const TGroup &group, const int index) {
+        double u = 0;
+        auto &moldata = group.traits();
+        if (!moldata.rigid) {
+            if (group.atomic) {
+                const size_t first = std::distance(spc.p.begin(), group.begin());
+                u = particle2rangeParallel(group[index], first, first + index) +
+                    particle2rangeParallel(group[index], first + index + 1, first + group.size());
+            } else {
+                u = blockSum(group.size(), particle_block_size, [&](const int i) {
+                    if (i == index || moldata.isPairExcluded(index, i)) {
+                        return 0.0;
+                    }
+                    return particle2particle(group[index], group[i]);
+                });
+            }
+        }
+        return u;
+    }
+
+    /**
+     * @brief Partial internal energy of the group limited to the particles present in the index.
+     * @see PairingBasePolicy::groupInternal
+     */
+    template <typename TGroup, typename TIndex> double groupInternal(const TGroup &group, const TIndex &index) {
+        return index.size() == 1 ? groupInternal(group, index[0]) : base::groupInternal(group, index);
+    }
+
+    /**
+     * @brief Complete cartesian pairing between particles in a group and particles in other groups in space.
+     * @see PairingBasePolicy::group2all
+     */
+    template <typename TGroup> double group2all(const TGroup &group) {
+        double u = 0;
+        if (splitGroups()) {
+            u = blockSum(spc.groups.size(), 1, [&](const int i) {
+                const auto &other_group = spc.groups[i];
+                return (&other_group != &group) ? base::group2group(group, other_group) : 0.0;
+            });
+        } else {
+            for (auto &other_group : spc.groups) {
+                if (&other_group != &group) {
+                    u += group2groupParallel(group, other_group);
+                }
+            }
+        }
+        return u;
+    }
+
+    /**
+     * @brief Complete cartesian pairing between a single particle in a group and particles in other groups in space.
+     * @see PairingBasePolicy::group2all
+     */
+    template <typename TGroup> double group2all(const TGroup &group, const int index) {
+        double u = 0;
+        const auto &particle = group[index];
+        if (splitGroups()) {
+            u = blockSum(spc.groups.size(), 1, [&](const int i) {
+                double u_i = 0;
+                const auto &other_group = spc.groups[i];
+                if (&other_group != &group && !cut(other_group, group)) {
+                    u_i = particle2group(particle, other_group);
+                }
+                return u_i;
+            });
+        } else {
+            for (auto &other_group : spc.groups) {
+                if (&other_group != &group && !cut(other_group, group)) {
+                    const size_t first = std::distance(spc.p.begin(), other_group.begin());
+                    u += particle2rangeParallel(particle, first, first + other_group.size());
+                }
+            }
+        }
+        return u;
+    }
+
+    /**
+     * @brief Complete cartesian pairing between selected particles in a group and particles in other groups in space.
+     * @see PairingBasePolicy::group2all
+     */
+    template <typename TGroup> double group2all(const TGroup &group, const std::vector<int> &index) {
+        double u = 0;
+        if (index.size() == 1) {
+            u = group2all(group, index[0]);
+        } else if (splitGroups()) {
+            u = blockSum(spc.groups.size(), 1, [&](const int i) {
+                const auto &other_group = spc.groups[i];
+                return (&other_group != &group) ? base::group2group(group, other_group, index) : 0.0;
+            });
+        } else {
+            for (auto &other_group : spc.groups) {
+                if (&other_group != &group && !cut(group, other_group)) {
+                    u += blockSum(index.size(), particle_block_size, [&](const int i) {
+                        double u_i = 0;
+                        for (auto &other_particle : other_group) {
+                            u_i += particle2particle(group[index[i]], other_particle);
+                        }
+                        return u_i;
+                    });
+                }
+            }
+        }
+        return u;
+    }
+
+    /**
+     * @brief Energy change due to displaced particles in a group paired with particles in other groups in space;
+     * either the other groups or blocks of their particles are split among threads.
+     * @see PairingBasePolicy::group2allChange
+     */
+    template <typename TGroup>
+    double group2allChange(const TGroup &group, const TGroup &old_group, const std::vector<int> &index) {
+        double du = 0;
+        if (splitGroups()) {
+            auto range_change = [&](const Particle &particle, const Particle &old_particle, size_t first,
+                                    size_t last) { return particle2rangeChange(particle, old_particle, first, last); };
+            du = blockSum(spc.groups.size(), 1, [&](const int i) {
+                const auto &other_group = spc.groups[i];
+                return (&other_group != &group)
+                           ? base::group2groupChange(group, old_group, other_group, index, range_change)
+                           : 0.0;
+            });
+        } else {
+            auto range_change = [&](const Particle &particle, const Particle &old_particle, size_t first,
+                                    size_t last) {
+                return particle2rangeChangeParallel(particle, old_particle, first, last);
+            };
+            for (auto &other_group : spc.groups) {
+                if (&other_group != &group) {
+                    du += base::group2groupChange(group, old_group, other_group, index, range_change);
+                }
+            }
+        }
+        return du;
+    }
+
+    /**
+     * @brief Internal energy change of an atomic group due to a single displaced particle; the group particles
+     * are split among threads.
+     * @see PairingBasePolicy::groupInternalChange
+     */
+    template <typename TGroup> double groupInternalChange(const TGroup &group, const TGroup &old_group, const int index) {
+        assert(group.atomic);
+        double du = 0;
+        if (!group.traits().rigid) {
+            const size_t first = std::distance(spc.p.begin(), group.begin());
+            du = particle2rangeChangeParallel(group[index], old_group[index], first, first + index) +
+                 particle2rangeChangeParallel(group[index], old_group[index], first + index + 1, first + group.size());
+        }
+        return du;
+    }
+
+    /**
+     * @brief Cross pairing of particles between a union of groups and its complement in space; the complement
+     * groups are split among threads.
+     * @see PairingBasePolicy::groups2all
+     */
+    template <typename T> double groups2all(const T &group_index) {
+        double u = base::groups2self(group_index);
+        const std::vector<int> moved = group_index | ranges::to<std::vector>;
+        const std::vector<int> fixed = indexComplement(spc.groups.size(), moved) | ranges::to<std::vector>;
+        u += blockSum(fixed.size(), 1, [&](const int i) {
+            double u_i = 0;
+            const auto &fixed_group = spc.groups[fixed[i]];
+            for (auto moved_ndx : moved) {
+                u_i += base::group2group(spc.groups[moved_ndx], fixed_group);
+            }
+            return u_i;
+        });
+        return u;
+    }
+
+    /**
+     * @brief Cross pairing between all particles in the space.
+     * @see PairingBasePolicy::all
+     */
+    double all() {
+        return all([](auto &) { return true; });
+    }
+
+    /**
+     * @brief Cross pairing between all particles in the space.
+     *
+     * @param condition  a group filter if internal energy of the group shall be added
+     * @see PairingBasePolicy::all
+     */
+    template <typename TCondition> double all(TCondition condition) {
+        double u = 0;
+        if (splitGroups()) {
+            u = blockSum(spc.groups.size(), 1, [&](const int i) {
+                const auto &group = spc.groups[i];
+                double u_i = condition(group) ? base::groupInternal(group) : 0.0;
+                for (auto other_group_it = spc.groups.begin() + i + 1; other_group_it < spc.groups.end();
+                     ++other_group_it) {
+                    u_i += base::group2group(group, *other_group_it);
+                }
+                return u_i;
+            });
+        } else {
+            for (auto group_it = spc.groups.begin(); group_it < spc.groups.end(); ++group_it) {
+                if (condition(*group_it)) {
+                    u += groupInternal(*group_it);
+                }
+                for (auto other_group_it = std::next(group_it); other_group_it < spc.groups.end(); ++other_group_it) {
+                    u += group2groupParallel(*group_it, *other_group_it);
+                }
+            }
+        }
+        return u;
+    }
+};
+
+/**
+ * @brief Particle pairing using a cell list for the particles of atomic groups.
+ *
+ * Active particles of all atomic groups are stored in a periodic cell list with cells no smaller than the given
+ * cutoff. When a single particle of an atomic group moves, its pair energies with other atomic particles are summed
+ * only over the 26+1 neighbouring cells; molecular groups are paired as in PairingBasePolicy. As other summations
+ * pair all particles, the pair potential is required to vanish beyond the cutoff.
+ *
+ * The cell list follows the particle positions in the space: particles listed in the Change object are moved
+ * between cells prior to the energy evaluation and on sync, i.e., when the move is accepted or rejected.
+ * The list is rebuilt if the volume, the number of particles, or everything changes. Should a volume change
+ * leave less than three cells along a side, all particles are paired as in PairingBasePolicy until the box
+ * is large enough again. Only the cuboidal geometry is supported.
+ *
+ * @see CellList, PairingBasePolicy
+ */
+template <typename TPairEnergy, typename TCutoff>
+class PairingPolicyCellList : public PairingBasePolicy<TPairEnergy, TCutoff> {
+    typedef PairingBasePolicy<TPairEnergy, TCutoff> base;
+    typedef Eigen::Vector3i CellPoint;
+    using base::cut;
+    using base::groupIndex;
+    using base::particle2particle;
+    using base::particleIndex;
+    using base::spc;
+
+    double cell_cutoff = 0;               //!< minimal cell side length
+    bool use_cells = false;               //!< false if the box is too small for three cells along each side
+    CellList<CellPoint> cells;            //!< absolute indices of active particles from atomic groups
+    std::vector<CellPoint> particle_cell; //!< cell of each listed particle; indexed by the absolute particle index
+    std::vector<int> particle_group;      //!< group index of each listed particle; -1 if not listed
+
+    void rebuild() {
+        use_cells = (spc.geo.getLength() / cell_cutoff).minCoeff() >= 3.0;
+        if (!use_cells) { // e.g. compressed by a volume move; all particles are paired as in the base policy
+            return;
+        }
+        cells.resize(spc.geo.getLength(), cell_cutoff);
+        particle_cell.resize(spc.p.size());
+        particle_group.assign(spc.p.size(), -1);
+        for (auto &group : spc.groups) {
+            if (group.atomic) {
+                for (auto &particle : group) {
+                    const auto i = particleIndex(particle);
+                    particle_cell[i] = cells.p2c(particle.pos);
+                    particle_group[i] = groupIndex(group);
+                    cells.insert(i, particle_cell[i]);
+                }
+            }
+        }
+    }
+
+    void updateParticle(const Particle &particle) {
+        const auto i = particleIndex(particle);
+        const CellPoint cell = cells.p2c(particle.pos);
+        if (cell != particle_cell[i]) {
+            cells.move(i, particle_cell[i], cell);
+            particle_cell[i] = cell;
+        }
+    }
+
+  public:
+    static constexpr bool single_pass_change = false; //!< the cells of new and old positions differ
+    using base::base;
+    using base::group2all;
+    using base::groupInternal;
+
+    void from_json(const json &j) {
+        base::from_json(j);
+        if (spc.geo.type != Geometry::CUBOID) {
+            throw std::runtime_error("cell list requires a cuboidal geometry");
+        }
+        cell_cutoff = j.at("celllist").at("cutoff").get<double>();
+        base::requireVanishingPairEnergy(cell_cutoff, "celllist");
+        rebuild();
+        if (!use_cells) {
+            throw std::runtime_error("celllist: the box must be at least three times the cutoff along each side");
+        }
+    }
+
+    void to_json(json &j) const {
+        base::to_json(j);
+        j["celllist"] = {{"cutoff", cell_cutoff}, {"cells", use_cells ? (cells.KLM.array() + 1).prod() : 0}};
+    }
+
+    void init() { rebuild(); }
+
+    void update(const Change &change) {
+        base::update(change);
+        if (change.all || change.dV || change.dN) {
+            rebuild();
+        } else if (use_cells) {
+            for (auto &change_data : change.groups) {
+                const auto &group = spc.groups.at(change_data.index);
+                if (group.atomic) {
+                    if (change_data.all || change_data.atoms.empty()) {
+                        for (auto &particle : group) {
+                            updateParticle(particle);
+                        }
+                    } else {
+                        for (int i : change_data.atoms) {
+                            updateParticle(group[i]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Pairing between a single particle in a group and particles in other groups in space.
+     *
+     * For a particle in an atomic group, only particles of other atomic groups from the neighbouring cells
+     * are considered. Molecular groups are paired subject to the group cutoff.
+     *
+     * @param group
+     * @param index  a particle index relative to the group beginning
+     * @return energy sum between particle pairs
+     */
+    template <typename TGroup> double group2all(const TGroup &group, const int index) {
+        if (!group.atomic || !use_cells) {
+            return base::group2all(group, index);
+        }
+        double u = 0;
+        const auto &particle = group[index];
+        const int group_index = groupIndex(group);
+        cells.forEachNeighbor(cells.p2c(particle.pos), [&](const auto &cell) {
+            for (auto i : cell) {
+                if (particle_group[i] != group_index) {
+                    u += particle2particle(particle, spc.p[i]);
+                }
+            }
+        });
+        for (auto &other_group : spc.groups) {
+            if (!other_group.atomic && !cut(other_group, group)) {
+                for (auto &other_particle : other_group) {
+                    u += particle2particle(particle, other_particle);
+                }
+            }
+        }
+        return u;
+    }
+
+    template <typename TGroup> double group2all(const TGroup &group, const std::vector<int> &index) {
+        return index.size() == 1 ? group2all(group, index[0]) : base::group2all(group, index);
+    }
+
+    /**
+     * @brief Partial internal energy of a group limited to interactions of a single particle within the group.
+     *
+     * For atomic groups, only particles from the neighbouring cells are considered.
+     *
+     * @param group
+     * @param index  internal index of the selected particle within the group
+     * @return energy sum between particle pairs
+     */
+    template <typename TGroup> double groupInternal(const TGroup &group, const int index) {
+        if (!group.atomic || !use_cells) {
+            return base::groupInternal(group, index);
+        }
+        double u = 0;
+        const auto &particle = group[index];
+        const auto particle_index = particleIndex(particle);
+        const int group_index = groupIndex(group);
+        cells.forEachNeighbor(cells.p2c(particle.pos), [&](const auto &cell) {
+            for (auto i : cell) {
+                if (particle_group[i] == group_index && i != particle_index) {
+                    u += particle2particle(particle, spc.p[i]);
+                }
+            }
+        });
+        return u;
+    }
+
+    template <typename TGroup, typename TIndex> double groupInternal(const TGroup &group, const TIndex &index) {
+        return index.size() == 1 ? groupInternal(group, index[0]) : base::groupInternal(group, index);
+    }
+};
+
+/**
+ * @brief Particle pairing using Verlet neighbour lists for the particles of atomic groups.
+ *
+ * For each active particle of an atomic group, all other such particles within `cutoff + skin` are stored.
+ * When a single particle of an atomic group moves, its pair energies with other atomic particles are summed only
+ * over its neighbours; molecular groups are paired as in PairingBasePolicy. As other summations pair all particles,
+ * the pair potential is required to vanish beyond the cutoff.
+ *
+ * The lists remain valid as long as no two particles have moved more than the skin in total since the last rebuild.
+ * Displacements of the particles listed in the Change object are recorded prior to the energy evaluation and on sync,
+ * and the lists are lazily rebuilt once the two largest displacements exceed the skin. As those are tracked as upper
+ * bounds, they are refreshed by a linear scan before rebuilding. The lists are always rebuilt if the volume, the number
+ * of particles, or everything changes. A cell list speeds up the rebuild in large enough cuboidal boxes.
+ *
+ * @see PairingBasePolicy, PairingPolicyCellList
+ */
+template <typename TPairEnergy, typename TCutoff>
+class PairingPolicyVerletList : public PairingBasePolicy<TPairEnergy, TCutoff> {
+    typedef PairingBasePolicy<TPairEnergy, TCutoff> base;
+    using base::cut;
+    using base::groupIndex;
+    using base::particle2particle;
+    using base::particleIndex;
+    using base::spc;
+
+    double cutoff = 0;                              //!< pair potential cutoff
+    double skin = 0;                                //!< extra neighbour distance to allow for displacements
+    std::vector<std::vector<size_t>> neighbours;    //!< neighbours of each listed particle by absolute index
+    std::vector<int> particle_group;                //!< group index of each listed particle; -1 if not listed
+    std::vector<Point> reference_positions;         //!< particle positions at the last rebuild
+    std::vector<double> displacements;              //!< particle displacements since the last rebuild
+    std::array<double, 2> max_displacements{0, 0};  //!< upper bounds of the two largest displacements
+    CellList<Eigen::Vector3i> cells;                //!< cell list used for rebuilding
+    unsigned int number_of_rebuilds = 0;            //!< statistics
+
+    void rebuild() {
+        const auto number_of_particles = spc.p.size();
+        std::vector<size_t> listed; // absolute index of active particles in atomic groups
+        particle_group.assign(number_of_particles, -1);
+        for (auto &group : spc.groups) {
+            if (group.atomic) {
+                for (auto &particle : group) {
+                    listed.push_back(particleIndex(particle));
+                    particle_group[listed.back()] = groupIndex(group);
+                }
+            }
+        }
+        neighbours.resize(number_of_particles);
+        for (auto &particle_neighbours : neighbours) {
+            particle_neighbours.clear();
+        }
+        reference_positions.resize(number_of_particles);
+        displacements.assign(number_of_particles, 0.0);
+        max_displacements = {0.0, 0.0};
+        for (auto i : listed) {
+            reference_positions[i] = spc.p[i].pos;
+        }
+
+        const double list_cutoff = cutoff + skin;
+        const double list_cutoff_squared = list_cutoff * list_cutoff;
+        auto add_pair = [&](size_t i, size_t j) {
+            if (spc.geo.sqdist(spc.p[i].pos, spc.p[j].pos) < list_cutoff_squared) {
+                neighbours[i].push_back(j);
+                neighbours[j].push_back(i);
+            }
+        };
+        const Point box = spc.geo.getLength();
+        if (spc.geo.type == Geometry::CUBOID && (box / list_cutoff).minCoeff() >= 3.0) {
+            cells.resize(box, list_cutoff);
+            for (auto i : listed) {
+                cells.insert(i, cells.p2c(spc.p[i].pos));
+            }
+            for (auto i : listed) {
+                cells.forEachNeighbor(cells.p2c(spc.p[i].pos), [&](const auto &cell) {
+                    for (auto j : cell) {
+                        if (j > i) {
+                            add_pair(i, j);
+                        }
+                    }
+                });
+            }
+        } else {
+            for (auto i = listed.begin(); i != listed.end(); ++i) {
+                for (auto j = std::next(i); j != listed.end(); ++j) {
+                    add_pair(*i, *j);
+                }
+            }
+        }
+        number_of_rebuilds++;
+    }
+
+    void updateParticle(const Particle &particle) {
+        const auto i = particleIndex(particle);
+        const double displacement = std::sqrt(spc.geo.sqdist(particle.pos, reference_positions[i]));
+        displacements[i] = displacement;
+        if (displacement > max_displacements[0]) {
+            max_displacements = {displacement, max_displacements[0]};
+        } else if (displacement > max_displacements[1]) {
+            max_displacements[1] = displacement;
+        }
+    }
+
+    //! Rebuilds the lists if two particles may have moved more than the skin in total
+    void rebuildIfNeeded() {
+        if (max_displacements[0] + max_displacements[1] > skin) {
+            max_displacements = {0.0, 0.0};
+            for (auto displacement : displacements) { // refresh the upper bounds
+                if (displacement > max_displacements[0]) {
+                    max_displacements = {displacement, max_displacements[0]};
+                } else if (displacement > max_displacements[1]) {
+                    max_displacements[1] = displacement;
+                }
+            }
+            if (max_displacements[0] + max_displacements[1] > skin) {
+                rebuild();
+            }
+        }
+    }
+
+  public:
+    static constexpr bool single_pass_change = false; //!< the neighbours of new and old positions differ
+    using base::base;
+    using base::group2all;
+    using base::groupInternal;
+
+    void from_json(const json &j) {
+        base::from_json(j);
+        const auto &verletlist = j.at("verletlist");
+        cutoff = verletlist.at("cutoff").get<double>();
+        skin = verletlist.value("skin", 0.2 * cutoff);
+        if (cutoff <= 0.0 || skin < 0.0) {
+            throw std::runtime_error("verletlist: positive cutoff and non-negative skin required");
+        }
+        base::requireVanishingPairEnergy(cutoff, "verletlist");
+        rebuild();
+    }
+
+    void to_json(json &j) const {
+        base::to_json(j);
+        j["verletlist"] = {{"cutoff", cutoff}, {"skin", skin}, {"rebuilds", number_of_rebuilds}};
+    }
+
+    void init() { rebuild(); }
+
+    void update(const Change &change) {
+        base::update(change);
+        if (change.all || change.dV || change.dN) {
+            rebuild();
+        } else {
+            for (auto &change_data : change.groups) {
+                const auto &group = spc.groups.at(change_data.index);
+                if (group.atomic) {
+                    if (change_data.all || change_data.atoms.empty()) {
+                        for (auto &particle : group) {
+                            updateParticle(particle);
+                        }
+                    } else {
+                        for (int i : change_data.atoms) {
+                            updateParticle(group[i]);
+                        }
+                    }
+                }
+            }
+            rebuildIfNeeded();
+        }
+    }
+
+    /**
+     * @brief Pairing between a single particle in a group and particles in other groups in space.
+     *
+     * For a particle in an atomic group, only neighbours from other atomic groups are considered.
+     * Molecular groups are paired subject to the group cutoff.
+     *
+     * @param group
+     * @param index  a particle index relative to the group beginning
+     * @return energy sum between particle pairs
+     */
+    template <typename TGroup> double group2all(const TGroup &group, const int index) {
+        if (!group.atomic) {
+            return base::group2all(group, index);
+        }
+        double u = 0;
+        const auto &particle = group[index];
+        const int group_index = groupIndex(group);
+        for (auto i : neighbours[particleIndex(particle)]) {
+            if (particle_group[i] != group_index) {
+                u += particle2particle(particle, spc.p[i]);
+            }
+        }
+        for (auto &other_group : spc.groups) {
+            if (!other_group.atomic && !cut(other_group, group)) {
+                for (auto &other_particle : other_group) {
+                    u += particle2particle(particle, other_particle);
+                }
+            }
+        }
+        return u;
+    }
+
+    template <typename TGroup> double group2all(const TGroup &group, const std::vector<int> &index) {
+        return index.size() == 1 ? group2all(group, index[0]) : base::group2all(group, index);
+    }
+
+    /**
+     * @brief Partial internal energy of a group limited to interactions of a single particle within the group.
+     *
+     * For atomic groups, only neighbours are considered.
+     *
+     * @param group
+     * @param index  internal index of the selected particle within the group
+     * @return energy sum between particle pairs
+     */
+    template <typename TGroup> double groupInternal(const TGroup &group, const int index) {
+        if (!group.atomic) {
+            return base::groupInternal(group, index);
+        }
+        double u = 0;
+        const auto &particle = group[index];
+        const int group_index = groupIndex(group);
+        for (auto i : neighbours[particleIndex(particle)]) {
+            if (particle_group[i] == group_index) {
+                u += particle2particle(particle, spc.p[i]);
+            }
+        }
+        return u;
+    }
+
+    template <typename TGroup, typename TIndex> double groupInternal(const TGroup &group, const TIndex &index) {
+        return index.size() == 1 ? groupInternal(group, index[0]) : base::groupInternal(group, index);
+    }
+};
+
+/**
+ * @brief Group pairing using a cell list of the mass centres of molecular groups.
+ *
+ * Molecular groups are stored in a periodic cell list by their mass centres with cells no smaller than the largest
+ * group cutoff distance. When a molecular group moves, only molecular groups from the 26+1 neighbouring cells are
+ * paired with it, subject to the group cutoff as in PairingBasePolicy. Atomic groups have no meaningful mass centre,
+ * hence they are never cut and always paired. Moved atomic groups are paired with all groups.
+ *
+ * The cell list follows the mass centres in the space: groups listed in the Change object are moved between cells
+ * prior to the energy evaluation and on sync. The list is rebuilt if the volume, the number of particles, or
+ * everything changes. Should a volume change leave less than three cells along a side, all groups are paired as in
+ * PairingBasePolicy until the box is large enough again. Only the cuboidal geometry is supported.
+ *
+ * @see CellList, GroupCutoff, PairingBasePolicy
+ */
+template <typename TPairEnergy, typename TCutoff>
+class PairingPolicyGroupCellList : public PairingBasePolicy<TPairEnergy, TCutoff> {
+    typedef PairingBasePolicy<TPairEnergy, TCutoff> base;
+    typedef Eigen::Vector3i CellPoint;
+    using base::cut;
+    using base::groupIndex;
+    using base::spc;
+
+    double cell_cutoff = 0;            //!< minimal cell side length, i.e., the largest group cutoff distance
+    bool use_cells = false;            //!< false if the box is too small for three cells along each side
+    CellList<CellPoint> cells;         //!< indices of molecular groups
+    std::vector<CellPoint> group_cell; //!< cell of each molecular group; indexed by the group index
+    std::vector<int> atomic_groups;    //!< indices of atomic groups
+    std::vector<int> candidates;       //!< temporary storage of groups to pair with
+
+    void rebuild() {
+        use_cells = (spc.geo.getLength() / cell_cutoff).minCoeff() >= 3.0;
+        if (!use_cells) { // e.g. compressed by a volume move; all groups are paired as in the base policy
+            return;
+        }
+        cells.resize(spc.geo.getLength(), cell_cutoff);
+        group_cell.resize(spc.groups.size());
+        atomic_groups.clear();
+        for (auto &group : spc.groups) {
+            const auto i = groupIndex(group);
+            if (group.atomic) {
+                atomic_groups.push_back(i);
+            } else {
+                group_cell[i] = cells.p2c(group.cm);
+                cells.insert(i, group_cell[i]);
+            }
+        }
+    }
+
+    template <typename TGroup> void updateGroup(const TGroup &group) {
+        const auto i = groupIndex(group);
+        const CellPoint cell = cells.p2c(group.cm);
+        if (cell != group_cell[i]) {
+            cells.move(i, group_cell[i], cell);
+            group_cell[i] = cell;
+        }
+    }
+
+    /**
+     * @brief Calls `f(other_group)` for each group which may be within the cutoff of the given group(s).
+     *
+     * For a molecular group, these are all atomic groups and molecular groups in the neighbouring cells of
+     * the given mass centres, otherwise, or if the cells are not in use, all groups. The group itself is excluded.
+     *
+     * @param group  group in this space
+     * @param mass_centres  mass centres to find the neighbouring cells of, e.g., the new and the old one
+     */
+    template <typename TGroup, typename TFunction>
+    void forEachCandidate(const TGroup &group, std::initializer_list<Point> mass_centres, TFunction f) {
+        const int group_index = groupIndex(group);
+        if (group.atomic || !use_cells) {
+            for (auto &other_group : spc.groups) {
+                if (&other_group != &group) {
+                    f(other_group);
+                }
+            }
+            return;
+        }
+        candidates = atomic_groups;
+        std::vector<CellPoint> centre_cells;
+        for (const auto &mass_centre : mass_centres) {
+            const CellPoint cell = cells.p2c(mass_centre);
+            if (std::find(centre_cells.begin(), centre_cells.end(), cell) == centre_cells.end()) {
+                centre_cells.push_back(cell);
+                cells.forEachNeighbor(cell, [&](const auto &cell_groups) {
+                    candidates.insert(candidates.end(), cell_groups.begin(), cell_groups.end());
+                });
+            }
+        }
+        if (centre_cells.size() > 1) { // neighbourhoods may overlap
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        }
+        for (const int i : candidates) {
+            if (i != group_index) {
+                f(spc.groups[i]);
+            }
+        }
+    }
+
+  public:
+    using base::base;
+    using base::group2group;
+
+    void from_json(const json &j) {
+        base::from_json(j);
+        if (spc.geo.type != Geometry::CUBOID) {
+            throw std::runtime_error("group cell list requires a cuboidal geometry");
+        }
+        cell_cutoff = cut.maxCutoff();
+        if (!std::isfinite(cell_cutoff)) {
+            throw std::runtime_error("group cell list requires a finite cutoff_g2g");
+        }
+        rebuild();
+        if (!use_cells) {
+            throw std::runtime_error("group cell list: the box must be at least three times the largest "
+                                     "cutoff_g2g along each side");
+        }
+    }
+
+    void to_json(json &j) const {
+        base::to_json(j);
+        j["group_celllist"] = true;
+    }
+
+    void init() { rebuild(); }
+
+    void update(const Change &change) {
+        base::update(change);
+        if (change.all || change.dV || change.dN) {
+            rebuild();
+        } else if (use_cells) {
+            for (auto &change_data : change.groups) {
+                const auto &group = spc.groups.at(change_data.index);
+                if (!group.atomic) {
+                    updateGroup(group);
+                }
+            }
+        }
+    }
+
+    template <typename TGroup> double group2all(const TGroup &group) {
+        double u = 0;
+        forEachCandidate(group, {group.cm}, [&](const TGroup &other_group) { u += group2group(group, other_group); });
+        return u;
+    }
+
+    template <typename TGroup> double group2all(const TGroup &group, const int index) {
+        double u = 0;
+        const auto &particle = group[index];
+        forEachCandidate(group, {group.cm}, [&](const TGroup &other_group) {
+            if (!cut(other_group, group)) {
+                u += base::particle2group(particle, other_group);
+            }
+        });
+        return u;
+    }
+
+    template <typename TGroup> double group2all(const TGroup &group, const std::vector<int> &index) {
+        if (index.size() == 1) {
+            return group2all(group, index[0]);
+        }
+        double u = 0;
+        forEachCandidate(group, {group.cm},
+                         [&](const TGroup &other_group) { u += group2group(group, other_group, index); });
+        return u;
+    }
+
+    /**
+     * @brief Energy change due to displaced particles in a group; groups neighbouring either the new or the old
+     * mass centre are considered.
+     * @see PairingBasePolicy::group2allChange
+     */
+    template <typename TGroup>
+    double group2allChange(const TGroup &group, const TGroup &old_group, const std::vector<int> &index) {
+        double du = 0;
+        forEachCandidate(group, {group.cm, old_group.cm}, [&](const TGroup &other_group) {
+            du += base::group2groupChange(group, old_group, other_group, index);
+        });
+        return du;
+    }
+};
+
+/**
+ * @brief Computes change in the non-bonded energy, assuming pair-wise additive energy terms.
+ *
+ * @tparam TPairingPolicy  pairing policy to effectively sum up the pair-wise additive non-bonded energy
+ */
+template <typename TPairingPolicy> class Nonbonded : public Energybase {
+  protected:
+    Space &spc;             //!< space to operate on
+    TPairingPolicy pairing; //!< pairing policy to effectively sum up the pair-wise additive non-bonded energy
+
+    /**
+     * @brief Computes non-bonded energy contribution if only a single group has changed.
+     *
+     * @param change
+     * @return energy sum between particle pairs
+     */
+    double energyGroup(Change &change) {
+        double u = 0;
+        const auto &change_data = change.groups[0];
+        const auto &group = spc.groups.at(change_data.index);
+        if (change_data.atoms.size() == 1) {
+            // faster algorithm if only a single particle moves
+            u = pairing.group2all(group, change_data.atoms[0]);
+            if (change_data.internal) {
+                u += pairing.groupInternal(group, change_data.atoms[0]);
+            }
+        } else {
+            const bool change_all = change_data.atoms.empty(); // all particles or only their subset?
+            u = change_all ? pairing.group2all(group) : pairing.group2all(group, change_data.atoms);
+            if (change_data.internal) {
                 u += change_all ? pairing.groupInternal(group) : pairing.groupInternal(group, change_data.atoms);
             }
         }
@@ -960,6 +2464,21 @@ template <typename TPairingPolicy> class Nonbonded : public Energybase {
 
     void to_json(json &j) const override { pairing.to_json(j); }
 
+    void init() override { pairing.init(); }
+
+    /**
+     * @brief Updates auxiliary pairing data of both terms to the synced particles.
+     *
+     * The other term is updated as well, as its energy may not have been evaluated for the change,
+     * e.g., when the Hamiltonian stops summing at the maximum energy.
+     */
+    void sync(Energybase *base_ptr, Change &change) override {
+        auto other = dynamic_cast<decltype(this)>(base_ptr);
+        assert(other);
+        pairing.update(change);
+        other->pairing.update(change);
+    }
+
     /**
      * @brief Calculates the force on all particles.
      *
@@ -979,6 +2498,7 @@ template <typename TPairingPolicy> class Nonbonded : public Energybase {
     double energy(Change &change) override {
         assert(std::is_sorted(change.groups.begin(), change.groups.end()));
         double u = 0;
+        pairing.update(change);
         if (change.all) {
             u = pairing.all();
         } else if (change.dV) {
@@ -998,40 +2518,181 @@ template <typename TPairingPolicy> class Nonbonded : public Energybase {
         }
         return u;
     }
+
+    /**
+     * @brief Computes the non-bonded energy change in a single pass if particles of only a single group move.
+     *
+     * The moved particles are paired in both their new and old positions with the static particles in a single
+     * sweep, instead of evaluating the energies of both states separately. Other changes are not supported.
+     *
+     * @param base_ptr  the corresponding term of the old state
+     * @param change
+     * @return energy change, or `std::nullopt` if not supported
+     * @see PairingBasePolicy::group2allChange
+     */
+    std::optional<double> energyChange(Energybase *base_ptr, Change &change) override {
+        if constexpr (TPairingPolicy::single_pass_change) {
+            if (!change.all && !change.dV && !change.dN && change.groups.size() == 1) {
+                auto other = dynamic_cast<decltype(this)>(base_ptr);
+                assert(other);
+                pairing.update(change);
+                const auto &change_data = change.groups[0];
+                const auto &group = spc.groups.at(change_data.index);
+                const auto &old_group = other->spc.groups.at(change_data.index);
+                const bool change_all = change_data.atoms.empty(); // all particles or only their subset?
+                std::vector<int> all_index;
+                if (change_all) {
+                    all_index.resize(group.size());
+                    std::iota(all_index.begin(), all_index.end(), 0);
+                }
+                const auto &index = change_all ? all_index : change_data.atoms;
+                double du = pairing.group2allChange(group, old_group, index);
+                if (change_data.internal) {
+                    if (group.atomic && index.size() == 1) {
+                        du += pairing.groupInternalChange(group, old_group, index[0]);
+                    } else if (change_all) {
+                        du += pairing.groupInternal(group) - other->pairing.groupInternal(old_group);
+                    } else {
+                        du += pairing.groupInternal(group, index) - other->pairing.groupInternal(old_group, index);
+                    }
+                }
+                return du;
+            }
+        }
+        return std::nullopt;
+    }
 };
 
 
 /**
- * @brief Computes non-bonded energy contribution from changed particles. Cache group2group energy once calculated,
- * until a new trial configuration is provided. Not for general use as only partially implemented!
+ * @brief Non-bonded energy with cached group-to-group energies.
+ *
+ * Group-to-group energies are kept in a sparse symmetric cache; only pairs of active groups within the group
+ * cutoff are stored. In Monte Carlo moves, see energyChange(), the energies of pairs involving changed groups are
+ * recomputed in the trial state only, while the energies of the old state are taken from the cache of the old
+ * term. If a few particles of a single group move, the cached pair energies are updated by the energy change of
+ * the moved particles. Internal group energies are not cached and they are computed as in Nonbonded. The caches
+ * are synced by copying the entries of the changed groups. Hence, e.g., simulations with many rigid molecules
+ * reuse all unchanged group-to-group energies.
  *
- * Original implementation, only refurbished. Generally suboptimal as only PairingPolicy::group2group method
- * may be called.
- * No internal energy is ever computed. Cannot deal with particle count changes. And other unmentioned constrains.
+ * The plain energy() is not cached; it is used outside of Monte Carlo moves, e.g., in analysis.
  *
- * @tparam Tpairpot
+ * @tparam Tpairpot  pair potential
  */
 template <typename Tpairpot> class NonbondedCached : public Nonbonded<PairingPolicy<PairEnergy<Tpairpot>, GroupCutoff>> {
     typedef Nonbonded<PairingPolicy<PairEnergy<Tpairpot>, GroupCutoff>> base;
-    typedef typename Space::Tgroup Tgroup;
-    Eigen::MatrixXf cache;
+    typedef std::map<int, double> TCacheRow; //!< energies between a group and other groups by the group index
+    using base::pairing;
     using base::spc;
+    std::vector<TCacheRow> cache;  //!< sparse symmetric matrix of group-to-group energies
+    bool is_cache_updated = false; //!< cache entries of the changed groups reflect the last change
+
+    //! Cached energy between two groups; zero if not stored
+    double cachedEnergy(int i, int j) const {
+        auto it = cache[i].find(j);
+        return (it != cache[i].end()) ? it->second : 0.0;
+    }
 
-    double g2g(const Tgroup &g1, const Tgroup &g2) {
-        int i = &g1 - spc.groups.data();
-        int j = &g2 - spc.groups.data();
-        if (j < i) {
-            std::swap(i, j);
+    //! Stores the energy between two groups, or removes the pair if empty or beyond the group cutoff
+    void setCachedEnergy(int i, int j, double u) {
+        const auto &group1 = spc.groups[i], &group2 = spc.groups[j];
+        if (group1.empty() || group2.empty() || pairing.isCut(group1, group2)) {
+            cache[i].erase(j);
+            cache[j].erase(i);
+        } else {
+            cache[i][j] = cache[j][i] = u;
+        }
+    }
+
+    //! Recomputes the cached energies between a group and all other groups
+    void updateCacheRow(int i) {
+        const auto &group = spc.groups[i];
+        for (int j = 0; j < static_cast<int>(spc.groups.size()); ++j) {
+            if (j != i) {
+                setCachedEnergy(i, j, pairing.group2group(group, spc.groups[j]));
+            }
+        }
+    }
+
+    /**
+     * @brief Updates the cached energies between a group and all other groups if a few particles of the group moved.
+     *
+     * The energy change of the moved particles is added to the cached energies of the old state. Pairs crossing
+     * the group cutoff are recomputed.
+     *
+     * @param i  index of the group
+     * @param old_group  the same group in the old state
+     * @param index  list of moved particle indices in the group relative to the group beginning
+     * @param old_cache  the cache of the old state
+     */
+    void updateCacheRow(int i, const typename Space::Tgroup &old_group, const std::vector<int> &index,
+                        const NonbondedCached &old_cache) {
+        const auto &group = spc.groups[i];
+        for (int j = 0; j < static_cast<int>(spc.groups.size()); ++j) {
+            const auto &other_group = spc.groups[j];
+            if (j == i) {
+                continue;
+            } else if (pairing.isCut(group, other_group) || pairing.isCut(old_group, other_group)) {
+                setCachedEnergy(i, j, pairing.group2group(group, other_group));
+            } else {
+                setCachedEnergy(i, j, old_cache.cachedEnergy(i, j) +
+                                          pairing.group2groupChange(group, old_group, other_group, index));
+            }
+        }
+    }
+
+    //! Copies the cached energies between a group and all other groups from another cache
+    void copyCacheRow(int i, const NonbondedCached &other) {
+        for (auto [j, u] : cache[i]) {
+            cache[j].erase(i);
+        }
+        cache[i] = other.cache[i];
+        for (auto [j, u] : cache[i]) {
+            cache[j][i] = u;
+        }
+    }
+
+    //! Sum of the cached energies of pairs involving any of the groups; each pair is counted once
+    double cachedEnergy(const std::vector<int> &group_index) const {
+        double u = 0;
+        std::vector<bool> is_indexed(cache.size(), false);
+        for (int i : group_index) {
+            is_indexed[i] = true;
+        }
+        for (int i : group_index) {
+            for (auto [j, u_ij] : cache[i]) {
+                if (!is_indexed[j] || j > i) {
+                    u += u_ij;
+                }
+            }
         }
-        if (base::key == Energybase::NEW) { // if this is from the trial system,
-            cache(i, j) = base::pairing.group2group(g1, g2); // update the cache
+        return u;
+    }
+
+    //! Sum of all cached energies
+    double cachedEnergy() const {
+        double u = 0;
+        for (size_t i = 0; i < cache.size(); ++i) {
+            for (auto it = cache[i].upper_bound(i); it != cache[i].end(); ++it) {
+                u += it->second;
+            }
         }
-        return cache(i, j); // return (cached) value
+        return u;
     }
 
-    double g2g(const Tgroup &g1, const Tgroup &g2, [[maybe_unused]] const std::vector<int> &index) {
-        // index not implemented
-        return g2g(g1, g2);
+    //! Internal energy of a changed group if the number of particles changed; active particles only, see Nonbonded
+    double speciationInternal(const Change::data &change_data) {
+        double u = 0;
+        const auto &group = spc.groups.at(change_data.index);
+        if (!group.traits().rigid) {
+            std::vector<int> index;
+            std::copy_if(change_data.atoms.begin(), change_data.atoms.end(), std::back_inserter(index),
+                         [size = static_cast<int>(group.size())](int i) { return i < size; });
+            if (!index.empty()) {
+                u = change_data.all ? pairing.groupInternal(group) : pairing.groupInternal(group, index);
+            }
+        }
+        return u;
     }
 
   public:
@@ -1040,98 +2701,368 @@ template <typename Tpairpot> class NonbondedCached : public Nonbonded<PairingPol
         init();
     }
 
-  /**
-   * @brief Cache pair interactions in matrix.
-   */
+    /**
+     * @brief Caches all group-to-group energies.
+     */
     void init() override {
-        const auto groups_size = spc.groups.size();
-        cache.resize(groups_size, groups_size);
-        cache.setZero();
-        for (auto i = 0; i < groups_size - 1; ++i) {
-            for (auto j = i + 1; j < groups_size; ++j) {
-                cache(i, j) = base::pairing.group2group(spc.groups[i], spc.groups[j]);
+        base::init();
+        cache.assign(spc.groups.size(), TCacheRow());
+        for (int i = 0; i < static_cast<int>(spc.groups.size()); ++i) {
+            updateCacheRow(i);
+        }
+    }
+
+    /**
+     * @brief Computes the non-bonded energy change using the cached group-to-group energies of the old state.
+     *
+     * The cache entries of the changed groups are updated to the new state.
+     *
+     * @param base_ptr  the corresponding term of the old state
+     * @param change
+     * @return energy change
+     */
+    std::optional<double> energyChange(Energybase *base_ptr, Change &change) override {
+        auto other = dynamic_cast<decltype(this)>(base_ptr);
+        assert(other);
+        pairing.update(change);
+        double du = 0;
+        if (change.all || change.dV) {
+            init();
+            du = cachedEnergy() - other->cachedEnergy();
+            for (size_t i = 0; i < spc.groups.size(); ++i) {
+                const auto &group = spc.groups[i];
+                if (change.all || group.atomic || group.compressible) {
+                    du += pairing.groupInternal(group) - other->pairing.groupInternal(other->spc.groups[i]);
+                }
+            }
+        } else {
+            const auto moved = change.touchedGroupIndex() | ranges::to<std::vector>; // index of moved groups
+            const auto &change_data = change.groups.front();
+            const auto &group = spc.groups.at(change_data.index);
+            const auto &old_group = other->spc.groups.at(change_data.index);
+            const bool is_single_group = !change.dN && change.groups.size() == 1;
+            if (is_single_group && !change_data.atoms.empty() && 2 * change_data.atoms.size() < group.size()) {
+                updateCacheRow(change_data.index, old_group, change_data.atoms, *other);
+            } else {
+                for (int i : moved) {
+                    updateCacheRow(i);
+                }
+            }
+            du = cachedEnergy(moved) - other->cachedEnergy(moved);
+            if (change.dN) {
+                for (const auto &speciation_change_data : change.groups) {
+                    du += speciationInternal(speciation_change_data) -
+                          other->speciationInternal(speciation_change_data);
+                }
+            } else if (is_single_group && change_data.internal) {
+                if (change_data.atoms.empty()) {
+                    du += pairing.groupInternal(group) - other->pairing.groupInternal(old_group);
+                } else if (group.atomic && change_data.atoms.size() == 1) {
+                    du += pairing.groupInternalChange(group, old_group, change_data.atoms[0]);
+                } else {
+                    du += pairing.groupInternal(group, change_data.atoms) -
+                          other->pairing.groupInternal(old_group, change_data.atoms);
+                }
             }
         }
+        is_cache_updated = true;
+        return du;
     }
 
-    double energy(Change &change) override {
-        // Only g2g may be called there to compute (and cache) energy!
-        double u = 0;
-        if (change) {
-            if (change.all || change.dV) {
-                for (auto i = spc.groups.begin(); i < spc.groups.end(); ++i) {
-                    for (auto j = std::next(i); j < base::spc.groups.end(); ++j) {
-                        u += g2g(*i, *j);
+    /**
+     * @brief Copies the cache entries of the changed groups from the other term.
+     *
+     * If the energy change has not been evaluated in the trial state, e.g., when the Hamiltonian stops summing
+     * at the maximum energy, the entries are recomputed instead.
+     *
+     * @param base_ptr
+     * @param change
+     */
+    void sync(Energybase *base_ptr, Change &change) override {
+        auto other = dynamic_cast<decltype(this)>(base_ptr);
+        assert(other);
+        base::sync(base_ptr, change);
+        const bool is_stale = other->key == Energybase::NEW && !other->is_cache_updated;
+        if (change.all || change.dV) {
+            if (is_stale) {
+                init();
+            } else {
+                cache = other->cache;
+            }
+        } else {
+            for (int i : change.touchedGroupIndex()) {
+                if (is_stale) {
+                    updateCacheRow(i);
+                } else {
+                    copyCacheRow(i, *other);
+                }
+            }
+        }
+        is_cache_updated = other->is_cache_updated = false;
+    }
+};
+
+/**
+ * @brief Non-bonded energy with cached energies of particles in atomic groups.
+ *
+ * The old term keeps the interaction energy of each active particle in (non-rigid) atomic groups with all other
+ * active particles. If a single particle of an atomic group is changed, e.g., by AtomicTranslateRotate,
+ * AtomicSwapCharge or a speciation swap, the old energy is a lookup and only the new energy is summed up, see
+ * energyChange(). The pair energies of the trial state are kept and, on accept, the cached energies of all
+ * particles are updated incrementally using the pair energies of the old particle. Other changes are evaluated
+ * as in Nonbonded; accepted changes, including insertions and deletions, update the cache incrementally. Deleted
+ * particles of atomic groups are swapped to the end of the active range, also in the old space, hence the cached
+ * energies follow the swapped particles, which are identified by their cached positions, see reorder(). Volume
+ * changes and changes of everything invalidate the cache, which is then rebuilt when needed.
+ *
+ * The cache relies on fixed roles of the terms in the Monte Carlo simulation, i.e., the key of the term
+ * (Energybase::OLD or Energybase::NEW).
+ *
+ * @tparam TPairingPolicy  pairing policy to effectively sum up the pair-wise additive non-bonded energy
+ */
+template <typename TPairingPolicy> class NonbondedParticleCached : public Nonbonded<TPairingPolicy> {
+    typedef Nonbonded<TPairingPolicy> base;
+    using base::pairing;
+    using base::spc;
+
+    //! A particle of the changed group before the move
+    struct ChangedParticle {
+        int group_index;       //!< group index in the space
+        int index;             //!< particle index relative to the group beginning
+        Particle old_particle; //!< particle before the move
+        bool was_active;       //!< particle was active before the move
+    };
+
+    std::vector<double> particle_energies;   //!< old term: energy of each cached particle by the absolute index
+    std::vector<Point> cached_positions;     //!< old term: position of each particle when its energy was cached
+    bool is_cache_valid = false;             //!< old term: particle energies reflect the space
+    std::vector<ChangedParticle> changed;    //!< new term: changed particles before the trial move
+    bool is_change_recorded = false;         //!< new term: changed particles recorded for the last change
+    int trial_particle = -1;                 //!< new term: absolute index of a single moved particle; -1 if none
+    double trial_particle_energy = 0;        //!< new term: energy of the single moved particle in the trial state
+    std::vector<double> trial_pair_energies; //!< new term: pair energies of the single moved particle
+    std::vector<double> scratch;             //!< scratch storage for pair energies
+
+    //! True if the particle energies in the group are cached
+    template <typename TGroup> static bool isCached(const TGroup &group) {
+        return group.atomic && !group.traits().rigid;
+    }
+
+    //! True if the cache can be updated incrementally, i.e., neither the volume nor everything changes
+    static bool isIncremental(const Change &change) { return !change.all && !change.dV; }
+
+    //! Absolute index of the first particle in a group
+    template <typename TGroup> size_t firstIndex(const TGroup &group) const {
+        return std::distance(spc.p.begin(), group.begin());
+    }
+
+    //! Energy of a particle in a cached group with all other active particles
+    template <typename TGroup> double particleEnergy(const TGroup &group, int index) {
+        return pairing.group2all(group, index) + pairing.groupInternal(group, index);
+    }
+
+    //! Recomputes all cached particle energies
+    void rebuild() {
+        particle_energies.assign(spc.p.size(), 0.0);
+        cached_positions.resize(spc.p.size());
+        std::transform(spc.p.begin(), spc.p.end(), cached_positions.begin(),
+                       [](const auto &particle) { return particle.pos; });
+        for (const auto &group : spc.groups) {
+            if (isCached(group)) {
+                const size_t first = firstIndex(group);
+                for (int i = 0; i < static_cast<int>(group.size()); ++i) {
+                    particle_energies[first + i] = particleEnergy(group, i);
+                }
+            }
+        }
+        is_cache_valid = true;
+    }
+
+    //! Records the changed particles before the move from the old term
+    void recordChange(const NonbondedParticleCached &old_term, Change &change) {
+        changed.clear();
+        trial_particle = -1;
+        is_change_recorded = isIncremental(change);
+        if (is_change_recorded) {
+            for (const auto &change_data : change.groups) {
+                const auto &old_group = old_term.spc.groups.at(change_data.index);
+                const int old_size = old_group.size();
+                auto record = [&](int i) {
+                    changed.push_back({change_data.index, i, *(old_group.begin() + i), i < old_size});
+                };
+                if (change_data.atoms.empty()) {
+                    // inactive particles may be activated if the number of particles changes
+                    const int size = change.dN ? static_cast<int>(old_group.capacity()) : old_size;
+                    for (int i = 0; i < size; ++i) {
+                        record(i);
                     }
+                } else {
+                    std::for_each(change_data.atoms.begin(), change_data.atoms.end(), record);
                 }
-            } else {
-                if (change.groups.size() == 1) { // if exactly ONE molecule is changed
-                    auto &d = change.groups[0];
-                    auto &g1 = spc.groups.at(d.index);
-                    for (auto g2_it = spc.groups.begin(); g2_it < spc.groups.end(); ++g2_it) {
-                        if (&g1 != &(*g2_it)) {
-                            u += g2g(g1, *g2_it, d.atoms);
-                        }
+            }
+        }
+    }
+
+    /**
+     * @brief Swaps the cached energies along with particles swapped within atomic groups changing in size.
+     *
+     * A deletion from an atomic group swaps the deleted particle with the last active particle of the group,
+     * both in the trial and the old space, regardless of acceptance. Swapped particles are found among those
+     * not at their cached position, which is linear in the group capacity. Inserted particles have no match
+     * and are left to update().
+     */
+    void reorder(const Change &change) {
+        std::vector<size_t> displaced; // absolute indices of particles not at their cached position
+        for (const auto &change_data : change.groups) {
+            const auto &group = spc.groups.at(change_data.index);
+            if (change_data.dNatomic && isCached(group)) {
+                displaced.clear();
+                const size_t first = firstIndex(group);
+                for (size_t i = first; i < first + group.capacity(); ++i) {
+                    if (spc.p[i].pos != cached_positions[i]) {
+                        displaced.push_back(i);
                     }
-                } else {                                     // many molecules are changed
-                    auto moved = change.touchedGroupIndex(); // index of moved groups
-                    // moved<->moved
-                    if (change.moved2moved) {
-                        for (auto i = moved.begin(); i < moved.end(); ++i) {
-                            for (auto j = std::next(i); j < moved.end(); ++j) {
-                                u += g2g(spc.groups[*i], spc.groups[*j]);
-                            }
-                        }
+                }
+                // entries before `i` are in place, hence the cached entry of particle `i` is searched beyond
+                for (auto i = displaced.begin(); i != displaced.end(); ++i) {
+                    auto j = std::find_if(std::next(i), displaced.end(),
+                                          [&](auto k) { return cached_positions[k] == spc.p[*i].pos; });
+                    if (j != displaced.end()) {
+                        std::swap(particle_energies[*i], particle_energies[*j]);
+                        std::swap(cached_positions[*i], cached_positions[*j]);
                     }
-                    // moved<->static
-#if true
-                    // classic version
-                    auto fixed = indexComplement(spc.groups.size(), moved); // index of static groups
-                    for (auto i : moved) {
-                        for (auto j : fixed) {
-                            u += g2g(spc.groups[i], spc.groups[j]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Updates the cached particle energies to the accepted change recorded by the trial term.
+     *
+     * The space has been already synced, hence the changed particles are in their new state.
+     */
+    void update(const NonbondedParticleCached &trial_term) {
+        const bool is_single_particle = trial_term.trial_particle >= 0; // trial pair energies available?
+        for (const auto &changed_particle : trial_term.changed) {
+            const auto &changed_group = spc.groups[changed_particle.group_index];
+            const auto &particle = *(changed_group.begin() + changed_particle.index);
+            const bool is_active = changed_particle.index < static_cast<int>(changed_group.size());
+            for (const auto &group : spc.groups) {
+                if (isCached(group)) {
+                    const size_t first = firstIndex(group), last = first + group.size();
+                    scratch.resize(group.size());
+                    if (changed_particle.was_active) {
+                        pairing.particle2rangeEach(changed_particle.old_particle, first, last, scratch.data());
+                        for (size_t i = first; i < last; ++i) {
+                            particle_energies[i] -= scratch[i - first];
                         }
                     }
-#else
-                    // OMP-ready version
-                    auto fixed =
-                        indexComplement(spc.groups.size(), moved) | ranges::to<std::vector>; // index of static groups
-                    const size_t moved_size = moved.size();
-                    const size_t fixed_size = fixed.size();
-                    for (auto i = 0; i < moved_size; ++i) {
-                        for (auto j = 0; j < fixed_size; ++j) {
-                            u += g2g(spc.groups[moved[i]], spc.groups[fixed[j]]);
+                    if (is_single_particle) {
+                        for (size_t i = first; i < last; ++i) {
+                            particle_energies[i] += trial_term.trial_pair_energies[i];
+                        }
+                    } else if (is_active) {
+                        pairing.particle2rangeEach(particle, first, last, scratch.data());
+                        for (size_t i = first; i < last; ++i) {
+                            particle_energies[i] += scratch[i - first];
                         }
                     }
-#endif
                 }
             }
-            // more todo!
         }
-        return u;
+        // the energies of the changed particles themselves are reset as they include meaningless self-interactions
+        for (const auto &changed_particle : trial_term.changed) {
+            const auto &group = spc.groups[changed_particle.group_index];
+            if (isCached(group)) {
+                const size_t index = firstIndex(group) + changed_particle.index;
+                cached_positions[index] = spc.p[index].pos;
+                if (changed_particle.index < static_cast<int>(group.size())) {
+                    particle_energies[index] = is_single_particle ? trial_term.trial_particle_energy
+                                                                  : particleEnergy(group, changed_particle.index);
+                }
+            }
+        }
+    }
+
+  public:
+    using base::base;
+
+    void to_json(json &j) const override {
+        base::to_json(j);
+        j["particle_cache"] = true;
+    }
+
+    void init() override {
+        base::init();
+        is_cache_valid = false;
+    }
+
+    /**
+     * @brief Computes the non-bonded energy change; the old energy of a single changed particle in an atomic
+     * group is taken from the cache of the old term.
+     *
+     * @param base_ptr  the corresponding term of the old state
+     * @param change
+     * @return energy change, or `std::nullopt` if the energies of both states shall be evaluated separately
+     */
+    std::optional<double> energyChange(Energybase *base_ptr, Change &change) override {
+        auto other = dynamic_cast<decltype(this)>(base_ptr);
+        assert(other);
+        recordChange(*other, change);
+        if (is_change_recorded && change.groups.size() == 1) {
+            const auto &change_data = change.groups.front();
+            const auto &group = spc.groups.at(change_data.index);
+            if (isCached(group) && change_data.internal && !change_data.dNatomic && change_data.atoms.size() == 1) {
+                pairing.update(change);
+                if (!other->is_cache_valid) {
+                    other->rebuild();
+                }
+                trial_particle = firstIndex(group) + change_data.atoms.front();
+                const auto &particle = spc.p[trial_particle];
+                trial_pair_energies.resize(spc.p.size());
+                trial_particle_energy = 0;
+                for (const auto &other_group : spc.groups) { // atomic groups are never cut
+                    const size_t first = firstIndex(other_group), last = first + other_group.size();
+                    pairing.particle2rangeEach(particle, first, last, &trial_pair_energies[first]);
+                    if (&other_group == &group) {
+                        trial_pair_energies[trial_particle] = 0.0; // no self-interaction
+                    }
+                    trial_particle_energy = std::accumulate(&trial_pair_energies[first], &trial_pair_energies[last],
+                                                            trial_particle_energy);
+                }
+                return trial_particle_energy - other->particle_energies[trial_particle];
+            }
+        }
+        return base::energyChange(base_ptr, change);
     }
 
     /**
-     * @brief Copy energy matrix from other
+     * @brief Updates the cached particle energies of the old term on accept.
+     *
+     * If the changed particles have not been recorded in the trial state, e.g., when the Hamiltonian stops
+     * summing at the maximum energy, or if the volume or everything changes, the cache is invalidated. On reject,
+     * the cached energies follow the particles swapped in the old space by deletions.
+     *
      * @param base_ptr
      * @param change
      */
     void sync(Energybase *base_ptr, Change &change) override {
         auto other = dynamic_cast<decltype(this)>(base_ptr);
         assert(other);
-        if (change.all || change.dV) {
-            cache.triangularView<Eigen::StrictlyUpper>() =
-                (other->cache).template triangularView<Eigen::StrictlyUpper>();
-        } else {
-            for (auto &d : change.groups) {
-                for (int i = 0; i < d.index; i++) {
-                    cache(i, d.index) = other->cache(i, d.index);
-                }
-                for (size_t i = d.index + 1; i < spc.groups.size(); i++) {
-                    cache(d.index, i) = other->cache(d.index, i);
+        base::sync(base_ptr, change);
+        if (this->key == Energybase::OLD) { // accepted
+            if (is_cache_valid && other->is_change_recorded) {
+                if (change.dN) {
+                    reorder(change);
                 }
+                update(*other);
+            } else {
+                is_cache_valid = false;
             }
+        } else if (change.dN && other->is_cache_valid) { // rejected
+            other->reorder(change);
         }
+        is_change_recorded = other->is_change_recorded = false;
     }
 };
 
@@ -1180,11 +3111,36 @@ struct Example2D : public Energybase {
 class Hamiltonian : public Energybase, public BasePointerVector<Energybase> {
   protected:
     double maxenergy = pc::infty; //!< Maximum allowed energy change
+    bool early_rejection = false; //!< Evaluate the terms which are either zero or infinite first
     void to_json(json &j) const override;
     void addEwald(const json &j, Space &spc); //!< Adds an instance of reciprocal space Ewald energies (if appropriate)
+    template <typename TPairEnergy, bool parallel>
+    void addNonbonded(const json &j, Space &spc); //!< Adds a non-bonded term using the pairing policy from the input
   public:
     Hamiltonian(Space &spc, const json &j);
     double energy(Change &change) override; //!< Energy due to changes
+
+    /**
+     * @brief New and old energy due to changes evaluated by this (new) and the other (old) Hamiltonian.
+     *
+     * Terms that support a single-pass energy change, see Energybase::energyChange(), add their change to the new
+     * energy only. Hence only the difference of the returned energies is meaningful. Summing stops when the energy
+     * difference reaches the maximum energy, which by default is infinite, see earlyRejection().
+     *
+     * @param old_hamiltonian  Hamiltonian of the old state
+     * @param change
+     * @return pair of the new and the old energy
+     */
+    std::pair<double, double> energy(Hamiltonian &old_hamiltonian, Change &change);
+
+    /**
+     * @brief Whether the cheap terms whose energy is either zero or infinite are evaluated first.
+     *
+     * Terms are summed in the order given in the input, except that the container overlap, hard-wall confinement
+     * and constraints go first. An infinite energy change from any of them stops the summation, as no subsequent
+     * term can compensate it, hence the moves are accepted exactly as without early rejection.
+     */
+    bool earlyRejection() const { return early_rejection; }
     void init() override;
     void sync(Energybase *basePtr, Change &change) override;
 }; //!< Aggregates and sum energy terms
@@ -1,5 +1,6 @@
 #pragma once
 #include "energy.h"
+#include "potentials.h"
 #include "core.h"
 #include "units.h"
 
@@ -31,7 +32,7 @@ TEST_CASE("[Faunus] Ewald - EwaldData") {
     // Check number of wave-vectors using PBC
     PolicyIonIon ionion;
     ionion.updateBox(data, Point(10, 10, 10));
-    CHECK(data.k_vectors.cols() == 2975);
+    CHECK(data.k_vectors.cols() == 2787); // half-space, including half of the nx = 0 plane
     CHECK(data.Q_ion.size() == data.k_vectors.cols());
 
     // Check number of wave-vectors using IPBC
@@ -42,6 +43,55 @@ TEST_CASE("[Faunus] Ewald - EwaldData") {
     CHECK(data.Q_ion.size() == data.k_vectors.cols());
 }
 
+TEST_CASE("[Faunus] Ewald - tuneEwald") {
+    Space spc;
+    spc.p.resize(2);
+    spc.geo = R"( {"type": "cuboid", "length": 10} )"_json;
+    spc.p[0] = R"( {"pos": [0,0,0], "q": 1.0} )"_json;
+    spc.p[1] = R"( {"pos": [1,0,0], "q": -1.0} )"_json;
+    spc.groups.push_back(Group<Particle>(spc.p.begin(), spc.p.end()));
+
+    auto input = R"({"type": "ewald", "epsr": 1.0, "epss": 1.0, "tolerance": 0.01})"_json;
+    auto tuned = tuneEwald(input, spc);
+    CHECK(tuned["cutoff"].get<double>() <= 5.0);
+    CHECK(tuned["autotune"]["real space error"].get<double>() == Approx(0.01 / std::sqrt(2.0)));
+    CHECK(tuned["autotune"]["reciprocal space error"].get<double>() <= 0.01 / std::sqrt(2.0));
+
+    input["cutoff"] = 4.0; // kept fixed
+    tuned = tuneEwald(input, spc);
+    CHECK(tuned["cutoff"] == 4.0);
+    json output = EwaldData(tuned);
+    CHECK(output["alpha"] == tuned["alpha"]);
+    CHECK(output.count("autotune") == 1);
+
+    input["tolerance"] = 0.0;
+    CHECK_THROWS(tuneEwald(input, spc));
+}
+
+TEST_CASE("[Faunus] Ewald - tuneEwaldInput") {
+    Space spc1, spc2; // e.g. accepted and trial state; the random configurations differ
+    SpaceFactory::makeNaCl(spc1, 50, R"( {"type": "cuboid", "length": 30} )"_json);
+    SpaceFactory::makeNaCl(spc2, 50, R"( {"type": "cuboid", "length": 30} )"_json);
+    const auto energy = R"([{"nonbonded_coulombwca": {
+                            "coulomb": {"type": "ewald", "epsr": 80.0, "epss": 1.0, "tolerance": 0.001},
+                            "wca": {"mixing": "LB"}}}])"_json;
+    const auto tuned = tuneEwaldInput(energy, spc1);
+    const auto &coulomb = tuned[0]["nonbonded_coulombwca"]["coulomb"];
+    CHECK(coulomb.count("tolerance") == 0);
+    CHECK(coulomb.count("alpha") == 1);
+    CHECK(tuneEwaldInput(tuned, spc2) == tuned); // tuned input is final
+
+    // both Hamiltonians get the same parameters
+    Hamiltonian hamiltonian1(spc1, tuned), hamiltonian2(spc2, tuned);
+    json ewald1, ewald2;
+    hamiltonian1.find<Ewald>().front()->to_json(ewald1);
+    hamiltonian2.find<Ewald>().front()->to_json(ewald2);
+    CHECK(ewald1 == ewald2);
+    CHECK(ewald1["alpha"] == coulomb["alpha"]);
+    CHECK(ewald1["cutoff"] == coulomb["cutoff"]);
+    CHECK(ewald1["ncutoff"] == coulomb["ncutoff"]);
+}
+
 TEST_CASE("[Faunus] Ewald - IonIonPolicy") {
     using doctest::Approx;
     Space spc;
@@ -68,6 +118,28 @@ TEST_CASE("[Faunus] Ewald - IonIonPolicy") {
         CHECK(ionion.reciprocalEnergy(data) == Approx(0.21303063979675319 * data.bjerrum_length));
     }
 
+    SUBCASE("PBC partial update with cached phase factors") {
+        PolicyIonIon ionion;
+        ionion.updateBox(data, spc.geo.getLength());
+        ionion.updateComplex(data, spc.groups);
+        CHECK(data.phase_factors.cols() == 2);
+        ParticleVector old_particles = spc.p;
+        Space::Tgvec old_groups;
+        old_groups.push_back(Group<Particle>(old_particles.begin(), old_particles.end()));
+        Change change;
+        change.groups.emplace_back();
+        change.groups[0].index = 0;
+        change.groups[0].atoms = {1};
+        spc.p[1].charge = 1.0; // charge swap; the cached phase factors are reused
+        EwaldData old_data = data;
+        ionion.updateComplex(data, change, spc.groups, old_groups);
+        const double u_partial = ionion.reciprocalEnergy(data);
+        old_data.sync(data, change, old_groups); // accept
+        CHECK(ionion.reciprocalEnergy(old_data) == Approx(u_partial));
+        ionion.updateComplex(data, spc.groups);
+        CHECK(u_partial == Approx(ionion.reciprocalEnergy(data)));
+    }
+
     SUBCASE("PBCEigen") {
         PolicyIonIonEigen ionion;
         ionion.updateBox(data, spc.geo.getLength());
@@ -77,6 +149,19 @@ TEST_CASE("[Faunus] Ewald - IonIonPolicy") {
         CHECK(ionion.reciprocalEnergy(data) == Approx(0.21303063979675319 * data.bjerrum_length));
     }
 
+    SUBCASE("PBCEigen with inactive particles") {
+        ParticleVector particles = spc.p;
+        particles.push_back(spc.p[0]);
+        particles.back().pos = {2, 2, 2};
+        Space::Tgvec groups;
+        groups.push_back(Group<Particle>(particles.begin(), particles.end()));
+        groups.front().resize(2); // the last particle is inactive and ignored
+        PolicyIonIonEigen ionion;
+        ionion.updateBox(data, spc.geo.getLength());
+        ionion.updateComplex(data, groups);
+        CHECK(ionion.reciprocalEnergy(data) == Approx(0.21303063979675319 * data.bjerrum_length));
+    }
+
     SUBCASE("IPBC") {
         PolicyIonIonIPBC ionion;
         data.policy = EwaldData::IPBC;
@@ -87,16 +172,41 @@ TEST_CASE("[Faunus] Ewald - IonIonPolicy") {
         CHECK(ionion.reciprocalEnergy(data) == Approx(0.0865107467 * data.bjerrum_length));
     }
 
-    // IPBCEigen is under construction
-    /*SUBCASE("IPBCEigen") {
-        PolicyIonIonIPBCEigen ionion();
-        data.type = EwaldData::IPBCEigen;
+    SUBCASE("PME") {
+        EwaldData pme_data = R"({
+                "epsr": 1.0, "alpha": 0.894427190999916, "epss": 1.0, "ewaldscheme": "PME",
+                "ncutoff": 11.0, "spherical_sum": true, "cutoff": 5.0})"_json;
+        CHECK(pme_data.mesh_size == Eigen::Vector3i(44, 44, 44));
+        CHECK(pme_data.spline_order == 6);
+        PolicyIonIonPME ionion;
+        ionion.updateBox(pme_data, spc.geo.getLength());
+        ionion.updateComplex(pme_data, spc.groups);
+        CHECK(ionion.reciprocalEnergy(pme_data) == Approx(0.21303063979675319 * pme_data.bjerrum_length));
+
+        // partial update of a displaced particle equals the full update
+        ParticleVector old_particles = spc.p;
+        Space::Tgvec old_groups;
+        old_groups.push_back(Group<Particle>(old_particles.begin(), old_particles.end()));
+        spc.p[1].pos = {1.5, -0.5, 2.0};
+        Change change;
+        change.groups.emplace_back();
+        change.groups[0].index = 0;
+        change.groups[0].atoms = {1};
+        ionion.updateComplex(pme_data, change, spc.groups, old_groups);
+        const double u_partial = ionion.reciprocalEnergy(pme_data);
+        ionion.updateComplex(pme_data, spc.groups);
+        CHECK(u_partial == Approx(ionion.reciprocalEnergy(pme_data)));
+    }
+
+    SUBCASE("IPBCEigen") {
+        PolicyIonIonIPBCEigen ionion;
+        data.policy = EwaldData::IPBCEigen;
         ionion.updateBox(data, spc.geo.getLength());
         ionion.updateComplex(data, spc.groups);
-        CHECK(ionion.selfEnergy(data, c, spc.groups) == Approx(-1.0092530088080642 * data.lB));
-        CHECK(ionion.surfaceEnergy(data, c, spc.groups) == Approx(0.0020943951023931952 * data.lB));
-        CHECK(ionion.reciprocalEnergy(data) == Approx(0.0865107467 * data.lB));
-    }*/
+        CHECK(ionion.selfEnergy(data, c, spc.groups) == Approx(-1.0092530088080642 * data.bjerrum_length));
+        CHECK(ionion.surfaceEnergy(data, c, spc.groups) == Approx(0.0020943951023931952 * data.bjerrum_length));
+        CHECK(ionion.reciprocalEnergy(data) == Approx(0.0865107467 * data.bjerrum_length));
+    }
 }
 
 TEST_CASE("[Faunus] Ewald - IonIonPolicy Benchmarks") {
@@ -132,6 +242,477 @@ TEST_CASE("[Faunus] Ewald - IonIonPolicy Benchmarks") {
   }
 }
 
+TEST_CASE("[Faunus] PairingPolicy - parallel") {
+    using namespace Potential;
+    typedef PairEnergy<CombinedPairPotential<Coulomb, LennardJones>, false> TPairEnergy;
+    Space spc;
+    SpaceFactory::makeNaCl(spc, 300, R"( {"type": "cuboid", "length": 40} )"_json);
+    BasePointerVector<Energybase> potentials;
+    const auto j = R"({"coulomb": {"epsr": 80.0}, "lennardjones": {"mixing": "LB"}})"_json;
+    PairingPolicy<TPairEnergy, GroupCutoff, false> serial(spc, potentials);
+    PairingPolicy<TPairEnergy, GroupCutoff, true> parallel(spc, potentials);
+    serial.from_json(j);
+    parallel.from_json(j);
+
+    const auto &group = spc.groups.front();
+    const double u_all = parallel.all();
+    CHECK(u_all == Approx(serial.all()));
+    CHECK(u_all == parallel.all()); // summation order is deterministic
+    CHECK(parallel.groupInternal(group) == Approx(serial.groupInternal(group)));
+    CHECK(parallel.groupInternal(group, 5) == Approx(serial.groupInternal(group, 5)));
+}
+
+TEST_CASE("[Faunus] PairingPolicy - parallel group pairing") {
+    using namespace Potential;
+    typedef PairEnergy<CombinedPairPotential<Coulomb, LennardJones>, false> TPairEnergy;
+    pc::temperature = 298.15_K;
+    Faunus::atoms = R"([{ "Na": { "sigma": 3.8, "eps": 0.1, "q": 1.0 } },
+                        { "Cl": { "sigma": 4.0, "eps": 0.05, "q": -1.0 } }])"_json.get<decltype(atoms)>();
+    Faunus::molecules = R"([{ "salt": { "atomic": true, "atoms": ["Na", "Cl"] } },
+                            { "dimer": { "rigid": true, "structure": [{"Na": [0, 0, 0]}, {"Cl": [2.0, 0, 0]}] } }])"_json
+                            .get<decltype(molecules)>();
+    Space spc;
+    spc.geo = R"( {"type": "cuboid", "length": 40} )"_json;
+    // few groups split the particles among threads, many groups split the groups
+    int num_dimers = 0;
+    SUBCASE("Few groups") { num_dimers = 20; }
+    SUBCASE("Many groups") { num_dimers = 100; }
+    json molecules_to_insert = json::array();
+    molecules_to_insert.push_back({{"salt", {{"N", 100}}}});
+    molecules_to_insert.push_back({{"dimer", {{"N", num_dimers}}}});
+    InsertMoleculesInSpace::insertMolecules(molecules_to_insert, spc);
+    BasePointerVector<Energybase> potentials;
+    const auto j = R"({"coulomb": {"epsr": 80.0}, "lennardjones": {"mixing": "LB"}})"_json;
+    PairingPolicy<TPairEnergy, GroupCutoff, false> serial(spc, potentials);
+    PairingPolicy<TPairEnergy, GroupCutoff, true> parallel(spc, potentials);
+    serial.from_json(j);
+    parallel.from_json(j);
+
+    const auto &salt = spc.groups.front(), &dimer = spc.groups.back();
+    CHECK(parallel.group2all(salt) == Approx(serial.group2all(salt)));
+    CHECK(parallel.group2all(dimer) == Approx(serial.group2all(dimer)));
+    CHECK(parallel.group2all(salt, 7) == Approx(serial.group2all(salt, 7)));
+    CHECK(parallel.group2all(salt, std::vector<int>{7}) == Approx(serial.group2all(salt, std::vector<int>{7})));
+    const std::vector<int> atoms_index = {1, 7, 150};
+    CHECK(parallel.group2all(salt, atoms_index) == Approx(serial.group2all(salt, atoms_index)));
+
+    const std::vector<int> single_group = {1}, multiple_groups = {0, 2, 5};
+    CHECK(parallel.groups2all(single_group) == Approx(serial.groups2all(single_group)));
+    CHECK(parallel.groups2all(multiple_groups) == Approx(serial.groups2all(multiple_groups)));
+
+    CHECK(parallel.group2groups(salt, spc.groups) == Approx(serial.group2groups(salt, spc.groups)));
+    CHECK(parallel.group2groups(dimer, spc.groups) == Approx(serial.group2groups(dimer, spc.groups)));
+    CHECK(parallel.group2groups(salt, multiple_groups, atoms_index) ==
+          Approx(serial.group2groups(salt, multiple_groups, atoms_index)));
+}
+
+TEST_CASE("[Faunus] PairingPolicy - vectorized kernel") {
+    using namespace Potential;
+    typedef CombinedPairPotential<Coulomb, WeeksChandlerAndersen> TPairPotential;
+    static_assert(PairEnergy<TPairPotential, false>::vectorizable);
+    static_assert(!PairEnergy<TPairPotential, true>::vectorizable);     // anisotropic potentials allowed
+    static_assert(!PairEnergy<FunctorPotential, false>::vectorizable); // no `isotropicEnergy()`
+    Space spc;
+    SpaceFactory::makeNaCl(spc, 300, R"( {"type": "cuboid", "length": 40} )"_json);
+    BasePointerVector<Energybase> potentials;
+    const auto j = R"({"coulomb": {"epsr": 80.0}, "wca": {"mixing": "LB"}})"_json;
+    PairingPolicy<PairEnergy<TPairPotential, true>, GroupCutoff> scalar(spc, potentials);
+    PairingPolicy<PairEnergy<TPairPotential, false>, GroupCutoff> vectorized(spc, potentials);
+    scalar.from_json(j);
+    vectorized.from_json(j);
+    REQUIRE(spc.getParticleArrays().size() == spc.p.size());
+
+    const auto &group = spc.groups.front();
+    for (int i : {0, 5, 599}) {
+        CHECK(vectorized.groupInternal(group, i) == Approx(scalar.groupInternal(group, i)));
+    }
+}
+
+TEST_CASE("[Faunus] PairingPolicy - cell list") {
+    using namespace Potential;
+    typedef PairEnergy<CombinedPairPotential<NewCoulombGalore, WeeksChandlerAndersen>, false> TPairEnergy;
+    Space spc;
+    SpaceFactory::makeNaCl(spc, 300, R"( {"type": "cuboid", "length": 40} )"_json);
+    BasePointerVector<Energybase> potentials;
+    const auto j = R"({"coulomb": {"type": "fanourgakis", "cutoff": 10.0, "epsr": 80.0}, "wca": {"mixing": "LB"},
+                       "celllist": {"cutoff": 10.0}})"_json;
+    PairingPolicy<TPairEnergy, GroupCutoff> plain(spc, potentials);
+    PairingPolicyCellList<TPairEnergy, GroupCutoff> celllist(spc, potentials);
+    plain.from_json(j);
+    celllist.from_json(j);
+
+    const auto &group = spc.groups.front();
+    for (int i : {0, 5, 17}) {
+        CHECK(celllist.groupInternal(group, i) == Approx(plain.groupInternal(group, i)));
+    }
+
+    SUBCASE("Move across periodic boundary") {
+        Change change;
+        Change::data change_data;
+        change_data.index = 0;
+        change_data.internal = true;
+        change_data.atoms = {5};
+        change.groups.push_back(change_data);
+        for (const Point &position : {Point(19.9, -19.9, 0.0), Point(-19.9, 19.9, 19.9), Point(0.0, 0.0, 0.0)}) {
+            spc.p[5].pos = position;
+            celllist.update(change);
+            CHECK(celllist.groupInternal(group, change_data.atoms) ==
+                  Approx(plain.groupInternal(group, change_data.atoms)));
+        }
+    }
+    SUBCASE("Volume move to less than three cells") {
+        Change change;
+        change.dV = true;
+        json j_out;
+        for (const double side_length : {25.0, 40.0}) { // all particles are paired, then the cells are restored
+            spc.scaleVolume(std::pow(side_length, 3));
+            plain.update(change);
+            celllist.update(change);
+            celllist.to_json(j_out);
+            CHECK((j_out["celllist"]["cells"] == 0) == (side_length < 30.0));
+            for (int i : {0, 5, 17}) {
+                CHECK(celllist.groupInternal(group, i) == Approx(plain.groupInternal(group, i)));
+            }
+        }
+    }
+    CHECK_THROWS_AS(celllist.from_json(R"({"coulomb": {"type": "fanourgakis", "cutoff": 10.0, "epsr": 80.0},
+                    "wca": {"mixing": "LB"}, "celllist": {"cutoff": 15.0}})"_json), std::runtime_error);
+    CHECK_THROWS_AS(celllist.from_json(R"({"coulomb": {"type": "fanourgakis", "cutoff": 10.0, "epsr": 80.0},
+                    "wca": {"mixing": "LB"}, "celllist": {"cutoff": 8.0}})"_json), std::runtime_error); // not cut off
+}
+
+TEST_CASE("[Faunus] PairingPolicy - Verlet list") {
+    using namespace Potential;
+    typedef PairEnergy<CombinedPairPotential<NewCoulombGalore, WeeksChandlerAndersen>, false> TPairEnergy;
+    Space spc;
+    SpaceFactory::makeNaCl(spc, 300, R"( {"type": "cuboid", "length": 40} )"_json);
+    BasePointerVector<Energybase> potentials;
+    const auto j = R"({"coulomb": {"type": "fanourgakis", "cutoff": 10.0, "epsr": 80.0}, "wca": {"mixing": "LB"},
+                       "verletlist": {"cutoff": 10.0, "skin": 2.0}})"_json;
+    PairingPolicy<TPairEnergy, GroupCutoff> plain(spc, potentials);
+    PairingPolicyVerletList<TPairEnergy, GroupCutoff> verletlist(spc, potentials);
+    plain.from_json(j);
+    verletlist.from_json(j);
+
+    const auto &group = spc.groups.front();
+    Change change;
+    Change::data change_data;
+    change_data.index = 0;
+    change_data.internal = true;
+    change_data.atoms = {5};
+    change.groups.push_back(change_data);
+    // displacements within and beyond the skin; the latter triggers a rebuild
+    for (const Point &displacement : {Point(0.5, 0.0, 0.0), Point(0.0, 0.7, 0.0), Point(3.0, 3.0, 3.0)}) {
+        spc.p[5].pos += displacement;
+        spc.geo.boundary(spc.p[5].pos);
+        verletlist.update(change);
+        CHECK(verletlist.groupInternal(group, change_data.atoms) ==
+              Approx(plain.groupInternal(group, change_data.atoms)));
+    }
+    json j_out;
+    verletlist.to_json(j_out);
+    CHECK(j_out["verletlist"]["rebuilds"] == 2);
+    CHECK_THROWS_AS(verletlist.from_json(R"({"coulomb": {"type": "fanourgakis", "cutoff": 10.0, "epsr": 80.0},
+                    "wca": {"mixing": "LB"}, "verletlist": {"cutoff": 8.0}})"_json), std::runtime_error);
+}
+
+TEST_CASE("[Faunus] PairingPolicy - group cell list") {
+    using namespace Potential;
+    typedef PairEnergy<CombinedPairPotential<NewCoulombGalore, WeeksChandlerAndersen>, false> TPairEnergy;
+    pc::temperature = 298.15_K;
+    Faunus::atoms = R"([{ "Na": { "sigma": 3.8, "eps": 0.1, "q": 1.0 } },
+                        { "Cl": { "sigma": 4.0, "eps": 0.05, "q": -1.0 } }])"_json.get<decltype(atoms)>();
+    Faunus::molecules = R"([{ "salt": { "atomic": true, "atoms": ["Na", "Cl"] } },
+                            { "dimer": { "rigid": true, "structure": [{"Na": [0, 0, 0]}, {"Cl": [2.0, 0, 0]}] } }])"_json
+                            .get<decltype(molecules)>();
+    Space spc_old, spc_new;
+    const Geometry::Chameleon geometry = R"( {"type": "cuboid", "length": 40} )"_json;
+    spc_old.geo = geometry;
+    InsertMoleculesInSpace::insertMolecules(R"([{"salt": {"N": 20}}, {"dimer": {"N": 50}}])"_json, spc_old);
+    Change change_all;
+    change_all.all = true;
+    spc_new.sync(spc_old, change_all);
+    BasePointerVector<Energybase> potentials;
+    const auto j = R"({"coulomb": {"type": "fanourgakis", "cutoff": 10.0, "epsr": 80.0}, "wca": {"mixing": "LB"},
+                       "cutoff_g2g": 12.0, "group_celllist": true})"_json;
+    PairingPolicy<TPairEnergy, GroupCutoff> plain(spc_new, potentials);
+    PairingPolicyGroupCellList<TPairEnergy, GroupCutoff> celllist(spc_new, potentials);
+    plain.from_json(j);
+    celllist.from_json(j);
+
+    Change change;
+    Change::data change_data;
+    change_data.index = 5;
+    change.groups.push_back(change_data);
+    const std::vector<int> index = {0, 1};
+    // displacements within a cell and across the periodic boundary
+    for (const Point &displacement : {Point(1.0, 2.0, 3.0), Point(-8.0, 0.0, 25.0), Point(0.0, 21.0, 0.0)}) {
+        auto &group = spc_new.groups[5];
+        group.translate(displacement, spc_new.geo.getBoundaryFunc());
+        celllist.update(change);
+        CHECK(celllist.group2all(group) == Approx(plain.group2all(group)));
+        CHECK(celllist.group2all(group, 1) == Approx(plain.group2all(group, 1)));
+        CHECK(celllist.group2allChange(group, spc_old.groups[5], index) ==
+              Approx(plain.group2allChange(group, spc_old.groups[5], index)));
+        spc_old.sync(spc_new, change);
+    }
+    CHECK(celllist.group2all(spc_new.groups[0]) == Approx(plain.group2all(spc_new.groups[0]))); // atomic group
+
+    Change change_volume;
+    change_volume.dV = true;
+    for (const double side_length : {30.0, 40.0}) { // all groups are paired, then the cells are restored
+        spc_new.scaleVolume(std::pow(side_length, 3));
+        plain.update(change_volume);
+        celllist.update(change_volume);
+        const auto &group = spc_new.groups[5];
+        CHECK(celllist.group2all(group) == Approx(plain.group2all(group)));
+        CHECK(celllist.group2all(group, 1) == Approx(plain.group2all(group, 1)));
+    }
+    CHECK_THROWS_AS(celllist.from_json(R"({"coulomb": {"type": "fanourgakis", "cutoff": 10.0, "epsr": 80.0},
+                    "wca": {"mixing": "LB"}})"_json), std::runtime_error); // no cutoff_g2g
+}
+
+TEST_CASE("[Faunus] Nonbonded - single-pass energy change") {
+    using namespace Potential;
+    typedef PairEnergy<CombinedPairPotential<NewCoulombGalore, WeeksChandlerAndersen>, false> TPairEnergy;
+    Space spc_old, spc_new;
+    SpaceFactory::makeNaCl(spc_old, 300, R"( {"type": "cuboid", "length": 40} )"_json);
+    Change change_all;
+    change_all.all = true;
+    spc_new.sync(spc_old, change_all);
+    BasePointerVector<Energybase> potentials;
+    const auto j = R"({"coulomb": {"type": "fanourgakis", "cutoff": 10.0, "epsr": 80.0}, "wca": {"mixing": "LB"}})"_json;
+    Nonbonded<PairingPolicy<TPairEnergy, GroupCutoff>> nonbonded_old(j, spc_old, potentials);
+    Nonbonded<PairingPolicy<TPairEnergy, GroupCutoff>> nonbonded_new(j, spc_new, potentials);
+
+    Change change;
+    Change::data change_data;
+    change_data.index = 0;
+    change_data.internal = true;
+    change_data.atoms = {5};
+    change.groups.push_back(change_data);
+    spc_new.p[5].pos = {1.0, -2.0, 3.0};
+    spc_new.updateParticleArrays(change);
+    const double du = nonbonded_new.energy(change) - nonbonded_old.energy(change);
+    const auto du_single_pass = nonbonded_new.energyChange(&nonbonded_old, change);
+    REQUIRE(du_single_pass);
+    CHECK(*du_single_pass == Approx(du));
+
+    change.dN = true; // not supported
+    CHECK_FALSE(nonbonded_new.energyChange(&nonbonded_old, change));
+}
+
+TEST_CASE("[Faunus] NonbondedParticleCached") {
+    using namespace Potential;
+    typedef PairEnergy<CombinedPairPotential<NewCoulombGalore, WeeksChandlerAndersen>, false> TPairEnergy;
+    Space spc_old, spc_new;
+    SpaceFactory::makeNaCl(spc_old, 300, R"( {"type": "cuboid", "length": 40} )"_json);
+    Change change_all;
+    change_all.all = true;
+    spc_new.sync(spc_old, change_all);
+    BasePointerVector<Energybase> potentials;
+    const auto j = R"({"coulomb": {"type": "fanourgakis", "cutoff": 10.0, "epsr": 80.0}, "wca": {"mixing": "LB"}})"_json;
+    Nonbonded<PairingPolicy<TPairEnergy, GroupCutoff>> nonbonded_old(j, spc_old, potentials);
+    Nonbonded<PairingPolicy<TPairEnergy, GroupCutoff>> nonbonded_new(j, spc_new, potentials);
+    NonbondedParticleCached<PairingPolicy<TPairEnergy, GroupCutoff>> cached_old(j, spc_old, potentials);
+    NonbondedParticleCached<PairingPolicy<TPairEnergy, GroupCutoff>> cached_new(j, spc_new, potentials);
+    cached_old.key = Energybase::OLD;
+    cached_new.key = Energybase::NEW;
+
+    Change change;
+    Change::data change_data;
+    change_data.index = 0;
+    change_data.internal = true;
+    change.groups.push_back(change_data);
+    // moves of single particles; a charge swap; accepted, hence the cache is updated incrementally
+    for (auto [index, position] : {std::pair(5, Point(1.0, -2.0, 3.0)), std::pair(7, Point(1.0, -2.0, 5.0)),
+                                   std::pair(5, Point(-10.0, 0.0, 0.0))}) {
+        change.groups.front().atoms = {index};
+        spc_new.p[index].pos = position;
+        spc_new.p[index].charge *= -1.0;
+        spc_new.updateParticleArrays(change);
+        const double du = nonbonded_new.energy(change) - nonbonded_old.energy(change);
+        const auto du_cached = cached_new.energyChange(&cached_old, change);
+        REQUIRE(du_cached);
+        CHECK(*du_cached == Approx(du));
+        spc_old.sync(spc_new, change);
+        cached_old.sync(&cached_new, change);
+    }
+
+    // a single particle move, which is evaluated using the cache
+    auto check_single_move = [&](int index, const Point &position) {
+        change.groups.front() = change_data;
+        change.groups.front().atoms = {index};
+        spc_new.p[index].pos = position;
+        spc_new.updateParticleArrays(change);
+        const double du = nonbonded_new.energy(change) - nonbonded_old.energy(change);
+        const auto du_cached = cached_new.energyChange(&cached_old, change);
+        REQUIRE(du_cached);
+        CHECK(*du_cached == Approx(du));
+        spc_old.sync(spc_new, change);
+        cached_old.sync(&cached_new, change);
+    };
+
+    // deletions as in SpeciationMove: the deleted particle is swapped to the end in both spaces
+    const int last = static_cast<int>(spc_new.groups.front().size()) - 1;
+    Change change_dn;
+    change_dn.dN = true;
+    auto delete_particle = [&](int index) {
+        auto &group_new = spc_new.groups.front(), &group_old = spc_old.groups.front();
+        std::iter_swap(group_new.begin() + index, group_new.end() - 1);
+        std::iter_swap(group_old.begin() + index, group_old.end() - 1);
+        change_dn.groups = {change_data};
+        change_dn.groups.front().dNatomic = true;
+        change_dn.groups.front().atoms = {static_cast<int>(group_new.size()) - 1};
+        group_new.deactivate(group_new.end() - 1, group_new.end());
+        spc_new.updateParticleArrays(change_dn);
+        spc_old.updateParticleArrays(change_dn);
+        cached_new.energyChange(&cached_old, change_dn);
+    };
+
+    SUBCASE("Rejected deletion") {
+        delete_particle(3);
+        spc_new.sync(spc_old, change_dn);
+        cached_new.sync(&cached_old, change_dn);
+        check_single_move(3, Point(2.0, 0.0, -1.0));
+        check_single_move(last, Point(-3.0, 1.0, 0.0));
+    }
+
+    SUBCASE("Accepted deletion and insertion") {
+        delete_particle(3);
+        spc_old.sync(spc_new, change_dn);
+        cached_old.sync(&cached_new, change_dn);
+        check_single_move(3, Point(2.0, 0.0, -1.0));
+
+        auto &group_new = spc_new.groups.front();
+        group_new.activate(group_new.end(), group_new.end() + 1);
+        (group_new.end() - 1)->pos = Point(0.0, 4.0, 4.0);
+        spc_new.updateParticleArrays(change_dn);
+        cached_new.energyChange(&cached_old, change_dn);
+        spc_old.sync(spc_new, change_dn);
+        cached_old.sync(&cached_new, change_dn);
+        check_single_move(last, Point(-3.0, 1.0, 0.0));
+        check_single_move(5, Point(1.0, 1.0, 1.0));
+    }
+}
+
+TEST_CASE("[Faunus] NonbondedCached") {
+    using namespace Potential;
+    typedef CombinedPairPotential<NewCoulombGalore, WeeksChandlerAndersen> TPairPotential;
+    pc::temperature = 298.15_K;
+    Faunus::atoms = R"([{ "Na": { "sigma": 3.8, "eps": 0.1, "q": 1.0 } },
+                        { "Cl": { "sigma": 4.0, "eps": 0.05, "q": -1.0 } }])"_json.get<decltype(atoms)>();
+    Faunus::molecules = R"([{ "salt": { "atomic": true, "atoms": ["Na", "Cl"] } },
+                            { "dimer": { "rigid": true, "structure": [{"Na": [0, 0, 0]}, {"Cl": [2.0, 0, 0]}] } }])"_json
+                            .get<decltype(molecules)>();
+    Space spc_old, spc_new;
+    const Geometry::Chameleon geometry = R"( {"type": "cuboid", "length": 40} )"_json;
+    spc_old.geo = geometry;
+    InsertMoleculesInSpace::insertMolecules(R"([{"salt": {"N": 100}}, {"dimer": {"N": 20}}])"_json, spc_old);
+    Change change_all;
+    change_all.all = true;
+    spc_new.sync(spc_old, change_all);
+    BasePointerVector<Energybase> potentials;
+    const auto j = R"({"coulomb": {"type": "fanourgakis", "cutoff": 10.0, "epsr": 80.0}, "wca": {"mixing": "LB"},
+                       "cutoff_g2g": 15.0})"_json;
+    Nonbonded<PairingPolicy<PairEnergy<TPairPotential>, GroupCutoff>> nonbonded_old(j, spc_old, potentials);
+    Nonbonded<PairingPolicy<PairEnergy<TPairPotential>, GroupCutoff>> nonbonded_new(j, spc_new, potentials);
+    NonbondedCached<TPairPotential> cached_old(j, spc_old, potentials), cached_new(j, spc_new, potentials);
+    cached_old.key = Energybase::OLD;
+    cached_new.key = Energybase::NEW;
+
+    auto check_and_accept = [&](Change &change) {
+        const double du = nonbonded_new.energy(change) - nonbonded_old.energy(change);
+        CHECK(*cached_new.energyChange(&cached_old, change) == Approx(du));
+        spc_old.sync(spc_new, change);
+        cached_old.sync(&cached_new, change);
+    };
+
+    SUBCASE("Rigid molecule translation") {
+        Change change;
+        Change::data change_data;
+        change_data.index = 1;
+        change.groups.push_back(change_data);
+        for (const Point &displacement : {Point(1.0, 2.0, 3.0), Point(-8.0, 0.0, 5.0)}) {
+            spc_new.groups[1].translate(displacement, spc_new.geo.getBoundaryFunc());
+            check_and_accept(change);
+        }
+    }
+    SUBCASE("Single particle move") {
+        Change change;
+        Change::data change_data;
+        change_data.index = 0;
+        change_data.internal = true;
+        change_data.atoms = {5};
+        change.groups.push_back(change_data);
+        for (const Point &position : {Point(1.0, -2.0, 3.0), Point(10.0, 0.0, -5.0)}) {
+            spc_new.groups[0][5].pos = position;
+            spc_new.updateParticleArrays(change);
+            check_and_accept(change);
+        }
+    }
+}
+
+TEST_CASE("[Faunus] Hamiltonian - early rejection") {
+    Space spc_old, spc_new;
+    SpaceFactory::makeNaCl(spc_old, 10, R"( {"type": "cuboid", "length": 40} )"_json);
+    Change change_all;
+    change_all.all = true;
+    spc_new.sync(spc_old, change_all);
+    spc_old.p[0].pos = spc_new.p[0].pos = {5.0, 0.0, 0.0};
+    const auto j = R"([{"earlyrejection": true},
+        {"confine": {"type": "cuboid", "low": [-20, -20, -20], "high": [10, 20, 20], "k": 1.0, "molecules": ["salt"]}},
+        {"confine": {"type": "cuboid", "low": [12, -20, -20], "high": [20, 20, 20], "k": 1.0, "molecules": ["salt"]}},
+        {"confine": {"type": "sphere", "radius": 30, "k": "inf", "molecules": ["salt"]}}])"_json;
+    Hamiltonian hamiltonian_old(spc_old, j), hamiltonian_new(spc_new, j);
+    hamiltonian_old.key = Energybase::OLD;
+    hamiltonian_new.key = Energybase::NEW;
+    REQUIRE(hamiltonian_new.earlyRejection());
+
+    Change change;
+    Change::data change_data;
+    change_data.index = 0;
+    change_data.atoms = {0};
+    change.groups.push_back(change_data);
+    auto energy_change = [&]() {
+        const auto [u_new, u_old] = hamiltonian_new.energy(hamiltonian_old, change);
+        return u_new - u_old;
+    };
+    auto hard_wall = std::dynamic_pointer_cast<Confine>(hamiltonian_new.vec.front());
+    REQUIRE(hard_wall); // evaluated first
+    CHECK(hard_wall->isHard());
+
+    // the hard wall contributes zero, and the soft terms lower the energy; with a bias or ideal term making any
+    // positive energy change unacceptable, the move must still be accepted, hence all terms are summed
+    spc_new.p[0].pos = {15.0, 0.0, 0.0}; // leaves the region of the first soft confinement for that of the second
+    const double du = energy_change();
+    CHECK(du < 0.0);
+    CHECK(du == Approx(hamiltonian_new.energy(change) - hamiltonian_old.energy(change)));
+    spc_new.p[0].pos = {0.0, 0.0, 35.0}; // outside the hard wall
+    CHECK(std::isinf(energy_change()));
+}
+
+TEST_CASE("[Faunus] BondIncidence") {
+    const auto bonds = R"([{"harmonic": {"index": [10, 11], "k": 1.0, "req": 1.0}},
+                           {"harmonic": {"index": [11, 12], "k": 1.0, "req": 1.0}},
+                           {"harmonic": {"index": [12, 13], "k": 1.0, "req": 1.0}}])"_json
+                           .get<BasePointerVector<Potential::BondData>>();
+    BondIncidence incidence(bonds, 10, 5);
+    auto visited = [&](const std::vector<int> &particles) {
+        std::vector<int> bond_indices;
+        incidence.forEachBond(particles, [&](int bond) { bond_indices.push_back(bond); });
+        std::sort(bond_indices.begin(), bond_indices.end());
+        return bond_indices;
+    };
+    CHECK(visited({10}) == std::vector<int>{0});
+    CHECK(visited({11, 12}) == std::vector<int>{0, 1, 2}); // the shared bond is visited once
+    CHECK(visited({14, 9, 20}).empty());                   // unbonded or outside the index
+    CHECK(incidence.anyBonds(13, 20));
+    CHECK_FALSE(incidence.anyBonds(14, 20)); // particle 14 is unbonded
+    CHECK_FALSE(incidence.anyBonds(0, 10));
+    CHECK_THROWS(BondIncidence(bonds, 11, 5));
+}
+
 #ifdef ENABLE_FREESASA
 TEST_CASE("[Faunus] FreeSASA") {
     Change change; // change object telling that a full energy calculation
@@ -14,6 +14,8 @@ void Energybase::to_json(json &) const {}
 
 void Energybase::sync(Energybase *, Change &) {}
 
+std::optional<double> Energybase::energyChange(Energybase *, Change &) { return std::nullopt; }
+
 void Energybase::init() {}
 
 void to_json(json &j, const Energybase &base) {
@@ -128,7 +130,7 @@ Confine::Confine(const json &j, Tspace &spc) : ExternalPotential(j, spc) {
             for (int i = 0; i < 3; ++i)
                 if (d[i] > 0)
                     u += d[i] * d[i];
-            return 0.5 * k * u;
+            return (u > 0) ? 0.5 * k * u : 0.0; // zero inside, also for an infinite spring constant
         };
     }
 }
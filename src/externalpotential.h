@@ -3,6 +3,7 @@
 #include "group.h"
 #include "auxiliary.h"
 #include <set>
+#include <optional>
 
 template<typename T> class ExprFunction;
 
@@ -26,6 +27,16 @@ class Energybase {
     virtual double energy(Change &) = 0;                  //!< energy due to change
     virtual void to_json(json &j) const;                  //!< json output
     virtual void sync(Energybase *, Change &);
+
+    /**
+     * @brief Energy change, `u_new - u_old`, summed in a single pass over both states if supported
+     *
+     * Called on the term of the new (trial) state with the corresponding term of the old state.
+     * The default implementation is not supported.
+     *
+     * @return energy change or `std::nullopt` if the energies of both states shall be evaluated separately
+     */
+    virtual std::optional<double> energyChange(Energybase *, Change &);
     virtual void init();                               //!< reset and initialize
     virtual inline void force(std::vector<Point> &){}; // update forces on all particles
     inline virtual ~Energybase(){};
@@ -163,6 +174,7 @@ class Confine : public ExternalPotential {
 
   public:
     Confine(const json &, Space &);
+    bool isHard() const { return std::isinf(k) && k > 0; } //!< True if the energy is either zero or infinite
     void to_json(json &) const override;
 }; //!< Confine particles to a sub-region of the simulation container
 
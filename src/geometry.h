@@ -339,6 +339,8 @@ class Chameleon : public GeometryBase {
     void boundary(Point &) const override;                    //!< Apply boundary conditions
     Point vdist(const Point &, const Point &) const override; //!< (Minimum) distance between two points
     double sqdist(const Point &, const Point &) const;        //!< (Minimum) squared distance between two points
+    void sqdist(const Point &, const double *, const double *, const double *, double *,
+                size_t) const; //!< (Minimum) squared distances between a point and coordinate arrays
     void randompos(Point &, Random &) const override;
     bool collision(const Point &) const override;
     void from_json(const json &) override;
@@ -442,6 +444,40 @@ inline double Chameleon::sqdist(const Point &a, const Point &b) const {
         return geometry->vdist(a, b).squaredNorm();
 }
 
+/**
+ * @brief (Minimum) squared distances between a point and `size` points given by coordinate arrays
+ *
+ * A vectorizable variant of `sqdist()` for structure-of-arrays data using the same branch-free
+ * minimum image convention for orthogonal boundary conditions.
+ *
+ * @param a  point
+ * @param x, y, z  coordinate arrays of the other points
+ * @param squared_distances  output array
+ * @param size  number of points
+ */
+inline void Chameleon::sqdist(const Point &a, const double *x, const double *y, const double *z,
+                              double *squared_distances, size_t size) const {
+    if (geometry->boundary_conditions.coordinates == ORTHOGONAL) {
+        const double ax = a.x(), ay = a.y(), az = a.z();
+        const double half_x = len_half.x(), half_y = len_half.y(), half_z = len_half.z();
+        const double box_x = len_or_zero.x(), box_y = len_or_zero.y(), box_z = len_or_zero.z();
+#pragma omp simd
+        for (size_t i = 0; i < size; ++i) {
+            double dx = std::fabs(ax - x[i]);
+            double dy = std::fabs(ay - y[i]);
+            double dz = std::fabs(az - z[i]);
+            dx -= static_cast<double>(dx > half_x) * box_x;
+            dy -= static_cast<double>(dy > half_y) * box_y;
+            dz -= static_cast<double>(dz > half_z) * box_z;
+            squared_distances[i] = dx * dx + dy * dy + dz * dz;
+        }
+    } else {
+        for (size_t i = 0; i < size; ++i) {
+            squared_distances[i] = geometry->vdist(a, {x[i], y[i], z[i]}).squaredNorm();
+        }
+    }
+}
+
 void to_json(json &, const Chameleon &);
 void from_json(const json &, Chameleon &);
 
@@ -23,6 +23,7 @@ MoleculeData::MoleculeData(const std::string &name, ParticleVector particles,
     if (!particles.empty()) {
         conformations.push_back(particles);
     }
+    partner_ranges = PartnerRanges(atoms.size(), exclusions);
 }
 
 int &MoleculeData::id() { return _id; }
@@ -219,6 +220,7 @@ void MoleculeBuilder::from_json(const json &j, MoleculeData &molecule) {
         molecule.setInserter(createInserter(j_properties));
         molecule.bonds = bonds;
         molecule.exclusions = ExclusionsVicinity::create(particles.size(), exclusion_pairs);
+        molecule.partner_ranges = PartnerRanges(particles.size(), molecule.exclusions);
 
         // todo better if these values have to be stored at all
         try {
@@ -508,6 +510,29 @@ void to_json(json &j, const ExclusionsVicinity &exclusions) {
     }
 }
 
+// ============ PartnerRanges ============
+
+PartnerRanges::PartnerRanges(int atoms_cnt, const ExclusionsVicinity &exclusions) {
+    offsets.reserve(atoms_cnt + 1);
+    forward_offsets.reserve(atoms_cnt);
+    for (int i = 0; i < atoms_cnt; ++i) {
+        offsets.push_back(ranges.size());
+        int first = 0; // first partner of the current range
+        for (int j = 0; j <= atoms_cnt; ++j) {
+            if (j == atoms_cnt || j == i || exclusions.isExcluded(i, j)) {
+                if (first < j) {
+                    ranges.emplace_back(first, j);
+                }
+                first = j + 1;
+            }
+        }
+        auto forward = std::find_if(ranges.begin() + offsets.back(), ranges.end(),
+                                    [i](const Range &range) { return range.first > i; });
+        forward_offsets.push_back(std::distance(ranges.begin(), forward));
+    }
+    offsets.push_back(ranges.size());
+}
+
 void from_json(const json &j, MoleculeInserter &inserter) { inserter.from_json(j); }
 void to_json(json &j, const MoleculeInserter &inserter) { inserter.to_json(j); }
 
@@ -169,6 +169,31 @@ inline std::pair<int, int> ExclusionsVicinity::fromIndex(int n) const {
 // void from_json(const json &j, ExclusionsVicinity &exclusions);  // not implemented
 void to_json(json &j, const ExclusionsVicinity &exclusions);
 
+/**
+ * @brief Non-excluded pairs of particles within a molecule in a compressed sparse row layout.
+ *
+ * The partners of each atom, i.e., all other atoms of the molecule except the excluded ones, are stored as
+ * ascending half-open ranges `[first, last)` of intramolecular indices. As exclusions are sparse, e.g., between
+ * bonded neighbours, only a few ranges per atom are needed and the pairs within each range can be streamed
+ * without checking for exclusions. The ranges of all atoms are concatenated; atom `i` owns the ranges from
+ * `begin(i)` to `end(i)`, of which those from `forward(i)` contain the partners with a larger index.
+ */
+class PartnerRanges {
+  public:
+    typedef std::pair<int, int> Range; //!< half-open range of intramolecular indices
+  private:
+    std::vector<Range> ranges;        //!< ranges of all atoms
+    std::vector<int> offsets;         //!< ranges of atom i are from `offsets[i]` to `offsets[i + 1]`
+    std::vector<int> forward_offsets; //!< first range of atom i with partners j > i
+  public:
+    PartnerRanges() = default;
+    PartnerRanges(int atoms_cnt, const ExclusionsVicinity &exclusions);
+    int size() const { return offsets.empty() ? 0 : static_cast<int>(offsets.size()) - 1; } //!< number of atoms
+    const Range *begin(int i) const { return ranges.data() + offsets[i]; }           //!< first range of atom i
+    const Range *forward(int i) const { return ranges.data() + forward_offsets[i]; } //!< first range with j > i
+    const Range *end(int i) const { return ranges.data() + offsets[i + 1]; }         //!< end of ranges of atom i
+};
+
 /**
  * @brief General properties for molecules
  */
@@ -180,6 +205,7 @@ class MoleculeData {
   protected:
     ExclusionsVicinity exclusions; //!< Implementation of isPairExcluded;
                                    //!< various implementation can be provided in the future
+    PartnerRanges partner_ranges;  //!< Non-excluded intramolecular pairs
   public:
     std::shared_ptr<MoleculeInserter> inserter = nullptr; //!< Functor for insertion into space
 
@@ -205,6 +231,8 @@ class MoleculeData {
 
     bool isPairExcluded(int i, int j) const;
 
+    const PartnerRanges &partnerRanges() const { return partner_ranges; } //!< Non-excluded intramolecular pairs
+
     /** @brief Specify function to be used when inserting into space.
      *
      * By default a random position and orientation is generator and overlap with container is avoided.
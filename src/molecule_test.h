@@ -128,6 +128,39 @@ TEST_CASE("[Faunus] ExclusionsVicinity") {
     CHECK_FALSE(exclusions.isExcluded(8,9));
 }
 
+TEST_CASE("[Faunus] PartnerRanges") {
+    std::vector<std::pair<int, int>> pairs{{0, 1}, {1, 2}, {1, 3}, {6, 7}};
+    auto exclusions = ExclusionsVicinity::create(10, pairs);
+    PartnerRanges partner_ranges(10, exclusions);
+    CHECK_EQ(partner_ranges.size(), 10);
+
+    // all partners of atom 1 are 4..9
+    CHECK_EQ(partner_ranges.end(1) - partner_ranges.begin(1), 1);
+    CHECK_EQ(*partner_ranges.begin(1), std::pair(4, 10));
+    // partners of atom 6 are 0..5 and 8..9; only the latter are forward
+    CHECK_EQ(partner_ranges.end(6) - partner_ranges.begin(6), 2);
+    CHECK_EQ(*partner_ranges.begin(6), std::pair(0, 6));
+    CHECK_EQ(*partner_ranges.forward(6), std::pair(8, 10));
+    CHECK_EQ(partner_ranges.forward(9), partner_ranges.end(9));
+
+    // the ranges cover exactly the non-excluded pairs
+    for (int i = 0; i < 10; ++i) {
+        int partners = 0;
+        for (auto range = partner_ranges.begin(i); range != partner_ranges.end(i); ++range) {
+            for (int j = range->first; j < range->second; ++j) {
+                CHECK(j != i);
+                CHECK_FALSE(exclusions.isExcluded(i, j));
+                ++partners;
+            }
+        }
+        int expected = 0;
+        for (int j = 0; j < 10; ++j) {
+            expected += (j != i && !exclusions.isExcluded(i, j));
+        }
+        CHECK_EQ(partners, expected);
+    }
+}
+
 TEST_CASE("[Faunus] MoleculeData") {
 //    json j = R"(
 //            { "moleculelist": [
@@ -63,10 +63,13 @@ double MCSimulation::drift() {
 
 /*
  * We need to construct two identical State objects and to avoid duplicate logs, we
- * temporarily disable the logger for the second object by the arcane _comma operator_
+ * temporarily disable the logger for the second object by the arcane _comma operator_.
+ * The trial state reuses the energy input tuned for the accepted state so that both
+ * Hamiltonians are identical.
  */
 MCSimulation::MCSimulation(const json &j, MPI::MPIController &mpi)
-    : log_level(faunus_logger->level()), state1(j), state2((faunus_logger->set_level(spdlog::level::off), j)),
+    : log_level(faunus_logger->level()), state1(j),
+      state2((faunus_logger->set_level(spdlog::level::off), j), state1.energy),
       moves((faunus_logger->set_level(log_level), j), state2.spc, mpi) {
     init();
 }
@@ -100,14 +103,13 @@ void MCSimulation::move() {
 #endif
             if (change) {
                 lastMoveName = (**mv).name; // store name of move for output
-                double unew, uold, du;
-                //#pragma omp parallel sections
-                {
-                    //#pragma omp section
-                    { unew = state2.pot.energy(change); }
-                    //#pragma omp section
-                    { uold = state1.pot.energy(change); }
+                state2.spc.updateParticleArrays(change); // refresh the (optional) SoA mirror of trial particles
+                if (change.dN) { // deletions from atomic groups also swap particles in the old space
+                    state1.spc.updateParticleArrays(change);
                 }
+                double unew, uold, du;
+                // terms capable of it sum the energy change in a single pass; see Hamiltonian::energy
+                std::tie(unew, uold) = state2.pot.energy(state1.pot, change);
 
                 du = unew - uold;
 
@@ -154,7 +156,10 @@ void MCSimulation::to_json(json &j) {
     j["last move"] = lastMoveName;
 }
 
-MCSimulation::State::State(const json &j) : spc(j), pot(spc, j.at("energy")) {}
+MCSimulation::State::State(const json &j)
+    : spc(j), energy(Energy::tuneEwaldInput(j.at("energy"), spc)), pot(spc, energy) {}
+
+MCSimulation::State::State(const json &j, const json &energy) : spc(j), energy(energy), pot(spc, energy) {}
 
 void MCSimulation::State::sync(MCSimulation::State &other, Change &change) {
     spc.sync(other.spc, change);
@@ -18,8 +18,10 @@ class MCSimulation {
 
     struct State {
         Space spc;
+        json energy; //!< Energy input with tuned parameters, see Energy::tuneEwaldInput()
         Energy::Hamiltonian pot;
-        State(const json &j);
+        State(const json &j);                     //!< Tunes the energy input on the initial configuration
+        State(const json &j, const json &energy); //!< Uses the given, already tuned energy input
 
         void sync(State &other, Change &change);
     }; //!< Contains everything to describe a state
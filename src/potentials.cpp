@@ -3,6 +3,7 @@
 #include "units.h"
 #include "spdlog/spdlog.h"
 #include <coulombgalore.h>
+#include <optional>
 
 namespace Faunus {
 namespace Potential {
@@ -271,6 +272,32 @@ void CustomPairPotential::from_json(const json &j) {
     _j["Rc"] = std::sqrt(Rc2);
     _j["T"] = pc::temperature;
     expr.set(jin, {{"r", &d->r}, {"q1", &d->q1}, {"q2", &d->q2}, {"s1", &d->s1}, {"s2", &d->s2}});
+    tabulate = j.value("tabulate", false);
+    if (tabulate)
+        tabulateExpression(j);
+}
+
+void CustomPairPotential::tabulateExpression(const json &j) {
+    double rmin = j.value("rmin", 1.0);
+    double rmax = j.value("rmax", std::sqrt(Rc2));
+    if (not std::isfinite(rmax))
+        throw std::runtime_error("tabulation requires a finite `cutoff` or `rmax`");
+    if (rmin <= 0 or rmin >= rmax)
+        throw std::runtime_error("tabulation requires 0 < rmin < rmax");
+    Tabulate::AndreaLookup<double> spline;
+    spline.setTolerance(j.value("utol", 1e-5), j.value("ftol", 1e-2));
+    arena = Tabulate::AndreaArena<double>();
+    tables = decltype(tables)(atoms.size());
+    for (size_t i = 0; i < atoms.size(); ++i) {
+        for (size_t k = 0; k <= i; ++k) {
+            auto knotdata = spline.generate(
+                [&](double r2) { return evaluate(atoms[i].charge, atoms[k].charge, atoms[i].sigma, atoms[k].sigma, r2); },
+                rmin * rmin, rmax * rmax);
+            tables.set(i, k, arena.add(knotdata));
+            faunus_logger->debug("Custom potential for {}-{} splined with {} knot(s)", atoms[i].name, atoms[k].name,
+                                 knotdata.numKnots());
+        }
+    }
 }
 
 void CustomPairPotential::to_json(json &j) const {
@@ -406,13 +433,13 @@ void FunctorPotential::registerSelfEnergy(PairPotentialBase *pot) {
         faunus_logger->trace("Failed to register non-defined selfEnergy() for {}", pot->name);
 }
 
-FunctorPotential::uFunc FunctorPotential::combineFunc(json &j) {
-    uFunc u = [](const Particle &, const Particle &, double, const Point &) { return 0.0; };
+FunctorPotential::TermSum FunctorPotential::combineFunc(json &j) {
+    TermSum u;
     if (j.is_array()) {
         for (auto &i : j) { // loop over all defined potentials in array
             if (i.is_object() and (i.size() == 1)) {
                 for (auto it : i.items()) {
-                    uFunc _u = nullptr;
+                    std::optional<Term> _u;
                     try {
                         if (it.key() == "custom")
                             _u = CustomPairPotential() = it.value();
@@ -469,10 +496,8 @@ FunctorPotential::uFunc FunctorPotential::combineFunc(json &j) {
                         throw std::runtime_error(it.key() + ": " + e.what() + usageTip[it.key()]);
                     }
 
-                    if (_u != nullptr) // if found, sum them into new function object
-                        u = [u, _u](const Particle &a, const Particle &b, double r2, const Point &r) {
-                            return u(a, b, r2, r) + _u(a, b, r2, r);
-                        };
+                    if (_u) // if found, add to the sum of potentials
+                        u.add(std::move(*_u));
                     else
                         throw std::runtime_error("unknown potential: " + it.key());
                 }
@@ -518,6 +543,8 @@ void TabulatedPotential::from_json(const json &j) {
     double u_at_rmin = j.value("u_at_rmin", 20);
     double u_at_rmax = j.value("u_at_rmax", 1e-6);
     hardsphere = j.value("hardsphere", false);
+    lookup = j.value("lookup", true);
+    arena = Tabulate::AndreaArena<double>();
 
     // build matrix of spline data, each element corresponding
     // to a pair of atom types
@@ -564,21 +591,22 @@ void TabulatedPotential::from_json(const json &j) {
 
                 assert(rmin2 < rmax2);
 
-                KnotData knotdata = spline.generate(
+                auto splinedata = spline.generate(
                     [&](double r2) {
                         return this->umatrix(i, k)(a, b, r2, {0, 0, 0});
                     },
-                    rmin2, rmax2);
+                    rmin2, rmax2, lookup);
+                KnotData knotdata = arena.add(splinedata);
 
                 // assert if potential is negative for r<rmin
-                if (spline.eval(knotdata, knotdata.rmin2 + dr) < 0) {
+                if (spline.eval(splinedata, splinedata.rmin2 + dr) < 0) {
                     assert(hardsphere == false && "`hardsphere` is set, but potential is negative for r<rmin");
                     knotdata.isNegativeBelowRmin = true;
-                } else
-                    matrix_of_knots.set(i, k, knotdata);
+                }
+                matrix_of_knots.set(i, k, knotdata);
 
                 faunus_logger->debug("Potential for {}-{} splined with {} knot(s)", atoms[i].name, atoms[k].name,
-                                     knotdata.numKnots());
+                                     splinedata.numKnots());
 
                 if (j.value("to_disk", false)) {
                     std::ofstream f(atoms[i].name + "-" + atoms[k].name + "_tabulated.dat"); // output file
@@ -591,6 +619,7 @@ void TabulatedPotential::from_json(const json &j) {
             }
         }
     }
+    faunus_logger->debug("Tabulated potentials occupy {} bytes", arena.bytes());
 }
 
 void NewCoulombGalore::setSelfEnergy() {
@@ -10,6 +10,8 @@
 #include <coulombgalore.h>
 #include <array>
 #include <functional>
+#include <mutex>
+#include <variant>
 
 /*
 namespace CoulombGalore {
@@ -172,6 +174,14 @@ template <class T1, class T2> struct CombinedPairPotential : public PairPotentia
         return first(a, b, r2, r) + second(a, b, r2, r);
     } //!< Combine pair energy
 
+    template <class U1 = T1, class U2 = T2>
+    inline auto isotropicEnergy(int id1, double charge1, int id2, double charge2, double r2) const
+        -> decltype(std::declval<const U1 &>().isotropicEnergy(id1, charge1, id2, charge2, r2) +
+                    std::declval<const U2 &>().isotropicEnergy(id1, charge1, id2, charge2, r2)) {
+        return first.isotropicEnergy(id1, charge1, id2, charge2, r2) +
+               second.isotropicEnergy(id1, charge1, id2, charge2, r2);
+    } //!< Combine pair energy from atom ids, charges, and distance; only if both potentials provide it
+
     inline Point force(const Particle &a, const Particle &b, double r2, const Point &p) const override {
         return first.force(a, b, r2, p) + second.force(a, b, r2, p);
     } //!< Combine force
@@ -240,10 +250,14 @@ class LennardJones : public MixerPairPotentialBase {
         return 6. * (*epsilon_quadruple)(a.id, b.id) * s6 * (2 * s6 - r6) / r14 * p;
     }
 
+    inline double isotropicEnergy(int id1, double, int id2, double, double r2) const {
+        double x = (*sigma_squared)(id1, id2) / r2;              // s2/r2
+        x = x * x * x;                                           // s6/r6
+        return (*epsilon_quadruple)(id1, id2) * (x * x - x);
+    }
+
     inline double operator()(const Particle &a, const Particle &b, double r2, const Point &) const override {
-        double x = (*sigma_squared)(a.id, b.id) / r2;              // s2/r2
-        x = x * x * x;                                             // s6/r6
-        return (*epsilon_quadruple)(a.id, b.id) * (x * x - x);
+        return isotropicEnergy(a.id, a.charge, b.id, b.charge, r2);
     }
 };
 
@@ -263,22 +277,22 @@ class LennardJones : public MixerPairPotentialBase {
 class WeeksChandlerAndersen : public LennardJones {
     static constexpr double onefourth = 0.25, twototwosixth = 1.2599210498948732;
 
-    inline double operator()(const Particle &a, const Particle &b, double r2) const {
-        double x = (*sigma_squared)(a.id, b.id); // s^2
+  public:
+    WeeksChandlerAndersen(const std::string &name = "wca", const std::string &cite = "doi:ct4kh9",
+                          CombinationRuleType combination_rule = COMB_LORENTZ_BERTHELOT)
+        : LennardJones(name, cite, combination_rule) {};
+
+    inline double isotropicEnergy(int id1, double, int id2, double, double r2) const {
+        double x = (*sigma_squared)(id1, id2); // s^2
         if (r2 > x * twototwosixth)
             return 0;
         x = x / r2;    // (s/r)^2
         x = x * x * x; // (s/r)^6
-        return (*epsilon_quadruple)(a.id, b.id) * (x * x - x + onefourth);
+        return (*epsilon_quadruple)(id1, id2) * (x * x - x + onefourth);
     }
 
-  public:
-    WeeksChandlerAndersen(const std::string &name = "wca", const std::string &cite = "doi:ct4kh9",
-                          CombinationRuleType combination_rule = COMB_LORENTZ_BERTHELOT)
-        : LennardJones(name, cite, combination_rule) {};
-
     inline double operator()(const Particle &a, const Particle &b, double r2, const Point &) const override {
-        return operator()(a, b, r2);
+        return isotropicEnergy(a.id, a.charge, b.id, b.charge, r2);
     }
 
     inline Point force(const Particle &a, const Particle &b, double r2, const Point &p) const override {
@@ -309,8 +323,12 @@ class HardSphere : public MixerPairPotentialBase {
     HardSphere(const std::string &name = "hardsphere")
         : MixerPairPotentialBase(name, std::string(), COMB_ARITHMETIC) {};
 
+    inline double isotropicEnergy(int id1, double, int id2, double, double r2) const {
+        return r2 < (*sigma_squared)(id1, id2) ? pc::infty : 0.0;
+    }
+
     inline double operator()(const Particle &a, const Particle &b, double r2, const Point &) const override {
-        return r2 < (*sigma_squared)(a.id, b.id) ? pc::infty : 0.0;
+        return isotropicEnergy(a.id, a.charge, b.id, b.charge, r2);
     }
 };
 
@@ -471,8 +489,11 @@ class SASApotential : public PairPotentialBase {
 struct Coulomb : public PairPotentialBase {
     Coulomb(const std::string &name = "coulomb") : PairPotentialBase(name) {};
     double lB; //!< Bjerrum length
+    inline double isotropicEnergy(int, double charge1, int, double charge2, double r2) const {
+        return lB * charge1 * charge2 / sqrt(r2);
+    }
     inline double operator()(const Particle &a, const Particle &b, double r2, const Point &) const override {
-        return lB * a.charge * b.charge / sqrt(r2);
+        return isotropicEnergy(a.id, a.charge, b.id, b.charge, r2);
     }
     void to_json(json &j) const override;
     void from_json(const json &j) override;
@@ -508,12 +529,16 @@ class Polarizability : public Coulomb {
 
     void to_json(json &j) const override { j = {{"epsr", epsr}}; }
 
-    inline double operator()(const Particle &a, const Particle &b, double r2, const Point &) const override {
+    inline double isotropicEnergy(int id1, double charge1, int id2, double charge2, double r2) const {
         double r4inv = 1 / (r2 * r2);
-        if (fabs(a.charge) > 1e-9 or fabs(b.charge) > 1e-9)
-            return (*m_charged)(a.id, b.id) * r4inv;
+        if (fabs(charge1) > 1e-9 or fabs(charge2) > 1e-9)
+            return (*m_charged)(id1, id2) * r4inv;
         else
-            return (*m_neutral)(a.id, b.id) / r2 * r4inv;
+            return (*m_neutral)(id1, id2) / r2 * r4inv;
+    }
+
+    inline double operator()(const Particle &a, const Particle &b, double r2, const Point &) const override {
+        return isotropicEnergy(a.id, a.charge, b.id, b.charge, r2);
     }
 
     inline Point force(const Particle &a, const Particle &b, double r2, const Point &p) const override {
@@ -567,8 +592,11 @@ class NewCoulombGalore : public PairPotentialBase {
 
   public:
     NewCoulombGalore(const std::string & = "coulomb");
+    inline double isotropicEnergy(int, double charge1, int, double charge2, double r2) const {
+        return lB * pot.ion_ion_energy(charge1, charge2, sqrt(r2) + std::numeric_limits<double>::epsilon());
+    }
     inline double operator()(const Particle &a, const Particle &b, double r2, const Point &) const override {
-        return lB * pot.ion_ion_energy(a.charge, b.charge, sqrt(r2) + std::numeric_limits<double>::epsilon());
+        return isotropicEnergy(a.id, a.charge, b.id, b.charge, r2);
     }
     Point force(const Particle &, const Particle &, double, const Point &) const override;
     void from_json(const json &) override;
@@ -587,6 +615,7 @@ class Multipole : public NewCoulombGalore {
 
   public:
     Multipole(const std::string & = "multipole");
+    double isotropicEnergy(int, double, int, double, double) const = delete; //!< angular dependent
     inline double operator()(const Particle &a, const Particle &b, double, const Point &r) const override {
         // Only dipole-dipole for now!
         Point mua = a.getExt().mu * a.getExt().mulen;
@@ -600,6 +629,10 @@ class Multipole : public NewCoulombGalore {
 
 /**
  * @brief Custom pair-potential taking math. expressions at runtime
+ *
+ * If `tabulate` is set, the expression is splined for each pair of atom types using the
+ * charge and sigma of the types. Outside the splined interval, or if a particle charge
+ * differs from that of its atom type, the expression is evaluated exactly.
  */
 class CustomPairPotential : public PairPotentialBase {
   private:
@@ -608,20 +641,39 @@ class CustomPairPotential : public PairPotentialBase {
     ExprFunction<double> expr;
     struct Data {
         double r = 0, q1 = 0, q2 = 0, s1 = 0, s2 = 0;
+        std::mutex mutex; // guards the above variables which are bound to `expr`
     };
     double Rc2;
     std::shared_ptr<Data> d;
     json jin; // initial json input
+    bool tabulate = false;                                   // use splines for each pair of atom types?
+    PairMatrix<Tabulate::AndreaArena<double>::table> tables; // location of the spline for each atom pair in `arena`
+    Tabulate::AndreaArena<double> arena;                     // splined expression for all atom pairs
+
+    //! Exact evaluation of the expression
+    inline double evaluate(double q1, double q2, double s1, double s2, double r2) const {
+        std::lock_guard<std::mutex> lock(d->mutex);
+        d->r = sqrt(r2);
+        d->q1 = q1;
+        d->q2 = q2;
+        d->s1 = s1;
+        d->s2 = s2;
+        return expr();
+    }
+
+    void tabulateExpression(const json &); //!< Spline expression for all pairs of atom types
+
   public:
     inline double operator()(const Particle &a, const Particle &b, double r2, const Point &) const override {
         if (r2 > Rc2)
             return 0;
-        d->r = sqrt(r2);
-        d->q1 = a.charge;
-        d->q2 = b.charge;
-        d->s1 = atoms[a.id].sigma;
-        d->s2 = atoms[b.id].sigma;
-        return expr();
+        if (tabulate) {
+            const auto &table = tables(a.id, b.id);
+            if (r2 > table.rmin2 and r2 <= table.rmax2 and a.charge == atoms[a.id].charge and
+                b.charge == atoms[b.id].charge)
+                return arena.eval(table, r2);
+        }
+        return evaluate(a.charge, b.charge, atoms[a.id].sigma, atoms[b.id].sigma, r2);
     }
     CustomPairPotential(const std::string & = "custom");
 
@@ -633,18 +685,47 @@ class CustomPairPotential : public PairPotentialBase {
 /**
  * @brief Arbitrary potentials for specific atom types
  *
- * This maintains a species x species matrix with function pointers (`std::function`)
- * that wraps pair potentials. Flexibility over performance.
+ * This maintains a species x species matrix with the sum of pair potentials for each pair.
+ * The summed potentials are stored by value in a flat list and called through `std::visit`
+ * so that each term costs a single jump, and not a nested `std::function` call.
  *
  * @todo `to_json` should retrieve info from potentials instead of merely passing input
  * @warning Each atom pair will be assigned an instance of a pair-potential. This *could* be
  *          problematic if these have large memory requirements.
  */
 class FunctorPotential : public PairPotentialBase {
-    typedef std::function<double(const Particle &, const Particle &, double, const Point &)> uFunc;
     json _j; // storage for input json
     typedef CombinedPairPotential<Coulomb, HardSphere> PrimitiveModel;
     typedef CombinedPairPotential<Coulomb, WeeksChandlerAndersen> PrimitiveModelWCA;
+
+    //! Any pair potential that can be summed for an atom pair
+    typedef std::variant<NewCoulombGalore, CosAttract, Polarizability, HardSphere, LennardJones, RepulsionR3,
+                         SASApotential, WeeksChandlerAndersen, PrimitiveModel, PrimitiveModelWCA, Hertz, SquareWell,
+                         Multipole, CustomPairPotential>
+        Term;
+
+    /**
+     * @brief Sum of pair potentials for a single atom pair
+     *
+     * The terms are called with a qualified name to skip the virtual call.
+     */
+    class TermSum {
+        std::vector<Term> terms;
+
+      public:
+        void add(Term &&term) { terms.push_back(std::move(term)); }
+        inline double operator()(const Particle &a, const Particle &b, double r2, const Point &r) const {
+            double u = 0.0;
+            for (const auto &term : terms)
+                u += std::visit(
+                    [&](const auto &pot) {
+                        using T = std::decay_t<decltype(pot)>;
+                        return pot.T::operator()(a, b, r2, r);
+                    },
+                    term);
+            return u;
+        }
+    };
     bool have_monopole_self_energy = false;
     bool have_dipole_self_energy = false;
     void registerSelfEnergy(PairPotentialBase *); //!< helper func to add to selv_energy_vector
@@ -670,10 +751,10 @@ class FunctorPotential : public PairPotentialBase {
                >
         potlist;
 
-    uFunc combineFunc(json &j); // parse json array of potentials to a single potential function object
+    TermSum combineFunc(json &j); // parse json array of potentials to a single sum of potentials
 
   protected:
-    PairMatrix<uFunc, true> umatrix; // matrix with potential for each atom pair; cannot be Eigen matrix
+    PairMatrix<TermSum, true> umatrix; // matrix with potential for each atom pair; cannot be Eigen matrix
 
   public:
     FunctorPotential(const std::string &name = "functor potential");
@@ -691,21 +772,26 @@ class FunctorPotential : public PairPotentialBase {
  *
  * This maintains a species x species matrix as in FunctorPotential
  * but with tabulated pair potentials to improve performance.
+ * The tables of all atom pairs are packed into a single contiguous
+ * buffer (`Tabulate::AndreaArena`) to keep them in as few cache lines
+ * as possible.
  *
  */
 class TabulatedPotential : public FunctorPotential {
 
-    // expand spline data class to hold information about
+    // expand table location in the arena to hold information about
     // the sign of values for r<rmin
-    struct KnotData : public Tabulate::TabulatorBase<double>::data {
-        typedef Tabulate::TabulatorBase<double>::data base;
+    struct KnotData : public Tabulate::AndreaArena<double>::table {
+        typedef Tabulate::AndreaArena<double>::table base;
         bool isNegativeBelowRmin = false;
         KnotData() = default;
         inline KnotData(const base &b) : base(b) {}
     };
-    PairMatrix<KnotData> matrix_of_knots; // matrix with tabulated potential for each atom pair; cannot be Eigen Matrix
-    Tabulate::Andrea<double> spline;      // spline class
+    PairMatrix<KnotData> matrix_of_knots;  // location of the tabulated potential for each atom pair in `arena`
+    Tabulate::AndreaArena<double> arena;   // contiguous storage of the tabulated potentials of all atom pairs
+    Tabulate::AndreaLookup<double> spline; // spline class
     bool hardsphere = false;          // use hardsphere for r<rmin?
+    bool lookup = true;               // find knots by a lookup table instead of a binary search?
 
   public:
     TabulatedPotential(const std::string &name = "splined") : FunctorPotential(name) {};
@@ -723,7 +809,7 @@ class TabulatedPotential : public FunctorPotential {
             else
                 return pc::infty; // assume extreme repulsion
         }
-        return spline.eval(knots, r2); // we are in splined interval
+        return arena.eval(knots, r2); // we are in splined interval
     }
 
     void from_json(const json &j) override;
@@ -253,6 +253,22 @@ TEST_CASE("[Faunus] CustomPairPotential") {
                 "function": "lB * q1 * q2 / (s1+s2) * exp(-kappa/r) * kT + pi"})"_json;
 
     CHECK(pot(a, b, 2 * 2, {0, 0, 2}) == Approx(-7 / (3.0 + 4.0) * std::exp(-30 / 2) * pc::kT() + pc::pi));
+
+    SUBCASE("tabulate") {
+        json j = R"({"function": "lB * q1 * q2 / r * exp(-r/D) + s1 * s2 / r^6",
+                     "constants": { "lB": 7, "D": 10}, "cutoff": 30, "rmin": 2, "tabulate": true})"_json;
+        CustomPairPotential splined = j;
+        j["tabulate"] = false;
+        CustomPairPotential exact = j;
+        for (double r : {1.5, 2.5, 3.0, 7.0, 29.0}) { // first distance is below rmin
+            CHECK(splined(a, b, r * r, {0, 0, r}) == Approx(exact(a, b, r * r, {0, 0, r})).epsilon(1e-3));
+            CHECK(splined(a, a, r * r, {0, 0, r}) == Approx(exact(a, a, r * r, {0, 0, r})).epsilon(1e-3));
+        }
+        CHECK(splined(a, b, 31 * 31, {0, 0, 31}) == 0);
+        b.charge = 0.5; // charge differs from atom type
+        CHECK(splined(a, b, 3 * 3, {0, 0, 3}) ==
+              Approx(7 * 0.5 / 3.0 * std::exp(-0.3) + atoms[0].sigma * atoms[1].sigma / std::pow(3, 6)));
+    }
 }
 
 TEST_CASE("[Faunus] FunctorPotential") {
@@ -292,6 +308,9 @@ TEST_CASE("[Faunus] FunctorPotential") {
     CHECK(u(c, c, (r * 1.01).squaredNorm(), r * 1.01) == 0);
     CHECK(u(c, c, (r * 0.99).squaredNorm(), r * 0.99) == pc::infty);
 
+    FunctorPotential u_copy = u; // summed potentials are stored by value
+    CHECK(u_copy(a, b, r2, r) == u(a, b, r2, r));
+
     SUBCASE("selfEnergy()") {
         // let's check that the self energy gets properly transferred to the functor potential
         json j = R"(
@@ -313,6 +332,21 @@ TEST_CASE("[Faunus] FunctorPotential") {
     }
 }
 
+TEST_CASE("[Faunus] TabulatedPotential") {
+    atoms = R"([{"A": {"q": 1.0, "r": 2.0}}, {"B": {"q": -1.0, "r": 2.0}}])"_json.get<decltype(atoms)>();
+    const auto j = R"({"default": [{"coulomb": {"epsr": 80.0, "type": "fanourgakis", "cutoff": 20}}],
+                       "rmax": 20})"_json;
+    FunctorPotential exact = j;
+    TabulatedPotential splined = j;
+    Particle a = atoms[0], b = atoms[1];
+    for (double r : {0.1, 1.0, 3.0, 7.0, 12.0}) { // first distance is below rmin
+        CHECK(splined(a, a, r * r, {0, 0, r}) == Approx(exact(a, a, r * r, {0, 0, r})).epsilon(1e-3));
+        // the attractive pair is negative below rmin, which must not leave it unsplined
+        CHECK(splined(a, b, r * r, {0, 0, r}) == Approx(exact(a, b, r * r, {0, 0, r})).epsilon(1e-3));
+    }
+    CHECK(splined(a, b, 21 * 21, {0, 0, 21}) == 0);
+}
+
 TEST_CASE("[Faunus] Dipole-dipole interactions") {
     json j = R"({ "atomlist" : [
                  {"A": { "mu":[1.0,0.0,0.0], "mulen":3.0 }},
@@ -62,11 +62,56 @@ void to_json(json &j, const Change &c) {
     j = {{"dV", c.dV}, {"all", c.all}, {"dN", c.dN}, {"moved2moved", c.moved2moved}, {"groups", c.groups}};
 }
 
+void ParticleArrays::set(const ParticleVector &particles) {
+    const auto size = particles.size();
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+    charge.resize(size);
+    id.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        set(i, particles[i]);
+    }
+}
+
 void Space::clear() {
     p.clear();
     groups.clear();
+    if (particle_arrays_enabled) {
+        particle_arrays.set(p);
+    }
+}
+
+void Space::enableParticleArrays() {
+    particle_arrays_enabled = true;
+    particle_arrays.set(p);
+}
+
+void Space::updateParticleArrays(const Change &change) {
+    if (particle_arrays_enabled) {
+        if (change.all || change.dV || particle_arrays.size() != p.size()) {
+            particle_arrays.set(p);
+        } else {
+            for (const auto &change_data : change.groups) {
+                const auto &group = groups.at(change_data.index);
+                const size_t offset = std::distance(p.begin(), group.begin());
+                // deletions from atomic groups swap particles within the group, see SpeciationMove
+                if (change_data.all || change_data.atoms.empty() || change_data.dNatomic) {
+                    for (size_t i = 0; i < group.capacity(); i++) { // inactive particles may have changed, too
+                        particle_arrays.set(offset + i, p[offset + i]);
+                    }
+                } else {
+                    for (auto i : change_data.atoms) {
+                        particle_arrays.set(offset + i, p[offset + i]);
+                    }
+                }
+            }
+        }
+    }
 }
 
+const ParticleArrays &Space::getParticleArrays() const { return particle_arrays; }
+
 void Space::push_back(int molid, const Space::Tpvec &in) {
     if (!in.empty()) {
         auto oldbegin = p.begin();
@@ -92,6 +137,9 @@ void Space::push_back(int molid, const Space::Tpvec &in) {
         groups.push_back(g);
         assert(groups.back().begin() == g.begin());
         assert(in.size() == groups.back().capacity());
+        if (particle_arrays_enabled) {
+            particle_arrays.set(p);
+        }
     }
 }
 
@@ -134,6 +182,7 @@ void Space::sync(Space &other, const Change &change) {
                     *(g.begin() + i) = *(gother.begin() + i);
         }
     }
+    updateParticleArrays(change);
     assert(p.size() == other.p.size());
     assert(p.begin() != other.p.begin());
 }
@@ -194,6 +243,10 @@ Point Space::scaleVolume(double Vnew, Geometry::VolumeMethod method) {
     if (method == Geometry::ISOCHORIC)
         Vold = std::pow(Vold, 1. / 3.);
 
+    if (particle_arrays_enabled) {
+        particle_arrays.set(p);
+    }
+
     for (auto f : scaleVolumeTriggers)
         f(*this, Vold, Vnew);
 
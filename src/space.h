@@ -56,6 +56,31 @@ struct Change {
 void to_json(json &, const Change::data &); //!< Serialize Change data to json
 void to_json(json &, const Change &);       //!< Serialise Change object to json
 
+/**
+ * @brief Structure-of-arrays mirror of a particle vector
+ *
+ * Positions, charges, and atom ids are stored in separate contiguous arrays which can be streamed
+ * by pair kernels instead of loading complete `Particle` objects. Element index equals the particle
+ * index in the mirrored vector.
+ */
+struct ParticleArrays {
+    std::vector<double> x, y, z; //!< Particle positions
+    std::vector<double> charge;  //!< Particle charges
+    std::vector<int> id;         //!< Atom ids
+
+    size_t size() const { return id.size(); }
+
+    inline void set(size_t i, const Particle &particle) {
+        x[i] = particle.pos.x();
+        y[i] = particle.pos.y();
+        z[i] = particle.pos.z();
+        charge[i] = particle.charge;
+        id[i] = particle.id;
+    } //!< Copy a single particle into the arrays
+
+    void set(const ParticleVector &particles); //!< Resize and copy all particles into the arrays
+};
+
 /**
  * @brief Placeholder for atoms and molecules
  * @tparam Tparticletype Particle type for the space
@@ -75,6 +100,9 @@ class Space {
      */
     std::map<int, int> implicit_reservoir;
 
+    bool particle_arrays_enabled = false; //!< Maintain the SoA mirror?
+    ParticleArrays particle_arrays;       //!< SoA mirror of `p`
+
   public:
     typedef Geometry::Chameleon Tgeometry;
     typedef Particle Tparticle; // remove
@@ -98,6 +126,16 @@ class Space {
     const std::map<int, int> &getImplicitReservoir() const; //!< Map of implicit molecule reservoirs
     std::map<int, int> &getImplicitReservoir();             //!< Map of implicit molecule reservoirs
 
+    /**
+     * @brief Creates and from now on maintains the SoA mirror of the particle vector
+     *
+     * The mirror is updated upon sync, volume scaling, and particle insertion. Particles modified
+     * directly in `p`, e.g. in a trial move, have to be refreshed using `updateParticleArrays()`.
+     */
+    void enableParticleArrays();
+    void updateParticleArrays(const Change &change); //!< Refreshes the SoA mirror for the changed particles
+    const ParticleArrays &getParticleArrays() const; //!< SoA mirror of `p`; empty unless enabled
+
     auto positions() const {
         return ranges::cpp20::views::transform(p, [](auto &i) -> const Point & { return i.pos; });
     } //!< Iterable range with positions
@@ -133,5 +133,41 @@ TEST_CASE("[Faunus] Space") {
     }
 }
 
+TEST_CASE("[Faunus] ParticleArrays") {
+    Space spc1, spc2;
+    SpaceFactory::makeNaCl(spc1, 10, R"( {"type": "cuboid", "length": 20} )"_json);
+    SpaceFactory::makeNaCl(spc2, 10, R"( {"type": "cuboid", "length": 20} )"_json);
+    CHECK(spc1.getParticleArrays().size() == 0); // disabled by default
+    spc1.enableParticleArrays();
+    spc2.enableParticleArrays();
+    const auto &arrays = spc1.getParticleArrays();
+    REQUIRE(arrays.size() == spc1.p.size());
+    CHECK(arrays.x[3] == spc1.p[3].pos.x());
+    CHECK(arrays.z[3] == spc1.p[3].pos.z());
+    CHECK(arrays.charge[3] == spc1.p[3].charge);
+    CHECK(arrays.id[3] == spc1.p[3].id);
+
+    Change change;
+    change.groups.push_back(Change::data());
+    change.groups.back().index = 0;
+    change.groups.back().atoms = {3};
+    spc1.p[3].pos = {1.0, 2.0, 3.0};
+    CHECK(arrays.y[3] != Approx(2.0)); // not yet refreshed
+    spc1.updateParticleArrays(change);
+    CHECK(arrays.y[3] == Approx(2.0));
+
+    spc2.sync(spc1, change);
+    CHECK(spc2.getParticleArrays().x[3] == Approx(1.0));
+    CHECK(spc2.getParticleArrays().x[2] == Approx(spc2.p[2].pos.x()));
+
+    // a deletion swaps the deleted particle with the last active one, but lists only the latter
+    std::iter_swap(spc1.p.begin() + 3, spc1.p.begin() + 19);
+    change.groups.back().atoms = {19};
+    change.groups.back().dNatomic = true;
+    spc1.updateParticleArrays(change);
+    CHECK(arrays.x[3] == spc1.p[3].pos.x());
+    CHECK(arrays.x[19] == Approx(1.0));
+}
+
 TEST_SUITE_END();
 } // namespace Faunus
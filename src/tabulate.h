@@ -153,15 +153,14 @@ template <typename T = double> class Andrea : public TabulatorBase<T> {
         return vb;
     }
 
-  public:
+  protected:
     /**
-     * @brief Get tabulated value at f(x)
+     * @brief Get tabulated value at f(x) using the given knot interval
      * @param d Table data
+     * @param pos Knot interval containing r2, i.e., `d.r2[pos] < r2 <= d.r2[pos + 1]`
      * @param r2 value
-     * @note Auto-vectorization in Clang: https://llvm.org/docs/Vectorizers.html
      */
-    inline T eval(const typename base::data &d, T r2) const {
-        size_t pos = std::lower_bound(d.r2.begin(), d.r2.end(), r2) - d.r2.begin() - 1;
+    inline T evalKnot(const typename base::data &d, size_t pos, T r2) const {
         size_t pos6 = 6 * pos;
         assert((pos6 + 5) < d.c.size());
         T dz = r2 - d.r2[pos];
@@ -178,12 +177,12 @@ template <typename T = double> class Andrea : public TabulatorBase<T> {
     }
 
     /**
-     * @brief Get tabulated value at df(x)/dx
+     * @brief Get tabulated value at df(x)/dx using the given knot interval
      * @param d Table data
+     * @param pos Knot interval containing r2
      * @param r2 value
      */
-    T evalDer(const typename base::data &d, T r2) const {
-        size_t pos = std::lower_bound(d.r2.begin(), d.r2.end(), r2) - d.r2.begin() - 1;
+    T evalDerKnot(const typename base::data &d, size_t pos, T r2) const {
         size_t pos6 = 6 * pos;
         T dz = r2 - d.r2[pos];
         return (d.c[pos6 + 1] +
@@ -191,6 +190,27 @@ template <typename T = double> class Andrea : public TabulatorBase<T> {
                         dz * (3.0 * d.c[pos6 + 3] + dz * (4.0 * d.c[pos6 + 4] + dz * (5.0 * d.c[pos6 + 5])))));
     }
 
+    //! Knot interval containing r2 found by a binary search
+    inline size_t searchKnot(const typename base::data &d, T r2) const {
+        return std::lower_bound(d.r2.begin(), d.r2.end(), r2) - d.r2.begin() - 1;
+    }
+
+  public:
+    /**
+     * @brief Get tabulated value at f(x)
+     * @param d Table data
+     * @param r2 value
+     * @note Auto-vectorization in Clang: https://llvm.org/docs/Vectorizers.html
+     */
+    inline T eval(const typename base::data &d, T r2) const { return evalKnot(d, searchKnot(d, r2), r2); }
+
+    /**
+     * @brief Get tabulated value at df(x)/dx
+     * @param d Table data
+     * @param r2 value
+     */
+    T evalDer(const typename base::data &d, T r2) const { return evalDerKnot(d, searchKnot(d, r2), r2); }
+
     /**
      * @brief Tabulate f(x) in interval ]min,max]
      */
@@ -300,6 +320,207 @@ template <typename T = double> class Andrea : public TabulatorBase<T> {
     }
 };
 
+/**
+ * @brief Andrea table with constant time knot lookup
+ *
+ * The knots and hence the accuracy are the same as in Andrea. In addition, the tabulated interval is divided
+ * into uniform bins in r2 and the first knot interval of each bin is stored. The knot interval of a given r2
+ * is then found by the bin index followed by a short linear search, instead of a binary search over all knots.
+ * The bin width is matched to the narrowest knot interval, limited by `max_bins_per_knot`.
+ */
+template <typename T = double> class AndreaLookup : public Andrea<T> {
+  private:
+    typedef Andrea<T> base;
+    int max_bins_per_knot = 16; // Limits the memory used by the lookup table
+
+  public:
+    struct data : public TabulatorBase<T>::data {
+        std::vector<unsigned int> knot_index; // First knot interval for each bin; empty if lookup is not used
+        T bin_origin = 0;                     // r2 of the first knot
+        T bin_scale = 0;                      // Inverse bin width
+        data() = default;
+        inline data(const typename TabulatorBase<T>::data &d) : TabulatorBase<T>::data(d) {}
+    };
+
+    /**
+     * @brief Build the lookup table of the knot intervals
+     * @param d Table data
+     */
+    void index(data &d) const {
+        d.knot_index.clear();
+        const size_t num_intervals = d.numKnots() - 1;
+        T min_width = d.r2.back() - d.r2.front();
+        for (size_t i = 0; i < num_intervals; i++)
+            min_width = std::min(min_width, d.r2[i + 1] - d.r2[i]);
+        const T range = d.r2.back() - d.r2.front();
+        const size_t num_bins =
+            std::clamp<size_t>(std::ceil(range / min_width), 1, max_bins_per_knot * num_intervals);
+        d.bin_origin = d.r2.front();
+        d.bin_scale = num_bins / range;
+        d.knot_index.resize(num_bins);
+        for (size_t bin = 0; bin < num_bins; bin++) {
+            const T edge = d.bin_origin + bin / d.bin_scale;
+            size_t pos = std::lower_bound(d.r2.begin(), d.r2.end(), edge) - d.r2.begin();
+            d.knot_index[bin] = (pos > 0) ? pos - 1 : 0; // last knot interval starting below the edge
+        }
+    }
+
+    /**
+     * @brief Knot interval containing r2, i.e., `d.r2[pos] < r2 <= d.r2[pos + 1]`
+     *
+     * Falls back to a binary search if no lookup table is built.
+     */
+    inline size_t findKnot(const data &d, T r2) const {
+        if (d.knot_index.empty())
+            return base::searchKnot(d, r2);
+        const T bin = (r2 - d.bin_origin) * d.bin_scale;
+        size_t pos = d.knot_index[std::min(size_t(std::max(bin, T(0))), d.knot_index.size() - 1)];
+        const size_t last = d.numKnots() - 2; // last knot interval
+        while (pos > 0 && d.r2[pos] >= r2)    // guards against rounding of the bin edges
+            pos--;
+        while (pos < last && d.r2[pos + 1] < r2)
+            pos++;
+        return pos;
+    }
+
+    /**
+     * @brief Get tabulated value at f(x)
+     * @param d Table data
+     * @param r2 value
+     */
+    inline T eval(const data &d, T r2) const { return base::evalKnot(d, findKnot(d, r2), r2); }
+
+    /**
+     * @brief Get tabulated value at df(x)/dx
+     * @param d Table data
+     * @param r2 value
+     */
+    T evalDer(const data &d, T r2) const { return base::evalDerKnot(d, findKnot(d, r2), r2); }
+
+    /**
+     * @brief Tabulate f(x) in interval ]min,max] and optionally build the lookup table
+     */
+    data generate(std::function<T(T)> f, double rmin, double rmax, bool lookup = true) {
+        data d = base::generate(f, rmin, rmax);
+        if (lookup)
+            index(d);
+        return d;
+    }
+};
+
+/**
+ * @brief Contiguous storage of many AndreaLookup tables
+ *
+ * All tables share a single, cache line aligned buffer. Each knot interval is stored as eight consecutive
+ * values, the lower r2, the six polynomial coefficients and one value of padding, so that intervals never
+ * straddle cache lines and evaluating an interval touches a single cache line. The knot intervals are followed
+ * by the upper r2 of the last interval and, starting on a new cache line, the lookup bins. Tables are referred
+ * to by offsets, so the arena can be copied freely.
+ */
+template <typename T = double> class AndreaArena {
+  private:
+    struct alignas(64) CacheLine {
+        unsigned char bytes[64];
+    };
+    std::vector<CacheLine> buffer;
+    static constexpr size_t stride = 8; // r2 + six coefficients + padding
+    static constexpr size_t values_per_line = sizeof(CacheLine) / sizeof(T);
+    static_assert(values_per_line % stride == 0, "knot intervals must not straddle cache lines");
+    static constexpr size_t indices_per_line = sizeof(CacheLine) / sizeof(unsigned int);
+
+    inline T *values() { return reinterpret_cast<T *>(buffer.data()); }
+    inline const T *values() const { return reinterpret_cast<const T *>(buffer.data()); }
+    inline unsigned int *indices() { return reinterpret_cast<unsigned int *>(buffer.data()); }
+    inline const unsigned int *indices() const { return reinterpret_cast<const unsigned int *>(buffer.data()); }
+
+  public:
+    //! Location of a single table in the arena
+    struct table {
+        size_t knots = 0;               // Offset of the first knot interval, in units of T
+        size_t bins = 0;                // Offset of the first lookup bin, in units of unsigned int
+        unsigned int num_intervals = 0; // Number of knot intervals; zero if empty
+        unsigned int num_bins = 0;      // Number of lookup bins; zero for binary search
+        T rmin2 = 0, rmax2 = 0;
+        T bin_origin = 0, bin_scale = 0;
+        bool empty() const { return num_intervals == 0; }
+    };
+
+    //! Number of bytes used by all tables
+    size_t bytes() const { return buffer.size() * sizeof(CacheLine); }
+
+    /**
+     * @brief Copy a table into the arena
+     * @returns Location of the table which is valid also after adding more tables
+     */
+    table add(const typename AndreaLookup<T>::data &d) {
+        table t;
+        t.rmin2 = d.rmin2;
+        t.rmax2 = d.rmax2;
+        if (d.numKnots() < 2)
+            return t;
+        t.num_intervals = d.numKnots() - 1;
+        t.num_bins = d.knot_index.size();
+        t.bin_origin = d.bin_origin;
+        t.bin_scale = d.bin_scale;
+        const size_t first_line = buffer.size();
+        const size_t knot_lines = (stride * t.num_intervals + 1 + values_per_line - 1) / values_per_line;
+        const size_t bin_lines = (t.num_bins + indices_per_line - 1) / indices_per_line;
+        buffer.resize(first_line + knot_lines + bin_lines);
+        t.knots = first_line * values_per_line;
+        t.bins = (first_line + knot_lines) * indices_per_line;
+        T *knots = values() + t.knots;
+        for (size_t i = 0; i < t.num_intervals; i++) {
+            knots[stride * i] = d.r2[i];
+            std::copy(d.c.begin() + 6 * i, d.c.begin() + 6 * i + 6, knots + stride * i + 1);
+        }
+        knots[stride * t.num_intervals] = d.r2.back();
+        std::copy(d.knot_index.begin(), d.knot_index.end(), indices() + t.bins);
+        return t;
+    }
+
+    /**
+     * @brief Knot interval containing r2, i.e., `r2[pos] < r2 <= r2[pos + 1]`
+     *
+     * Same result as AndreaLookup::findKnot(). Uses a binary search if the table has no lookup bins.
+     */
+    inline size_t findKnot(const table &t, T r2) const {
+        const T *knots = values() + t.knots;
+        if (t.num_bins == 0) { // binary search equivalent to std::lower_bound
+            size_t first = 0, count = t.num_intervals + 1;
+            while (count > 0) {
+                const size_t half = count / 2;
+                if (knots[stride * (first + half)] < r2) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else
+                    count = half;
+            }
+            return first - 1;
+        }
+        const T bin = (r2 - t.bin_origin) * t.bin_scale;
+        size_t pos = indices()[t.bins + std::min(size_t(std::max(bin, T(0))), size_t(t.num_bins - 1))];
+        while (pos > 0 && knots[stride * pos] >= r2)
+            pos--;
+        while (pos + 1 < t.num_intervals && knots[stride * (pos + 1)] < r2)
+            pos++;
+        return pos;
+    }
+
+    //! Get tabulated value at f(x)
+    inline T eval(const table &t, T r2) const {
+        const T *knot = values() + t.knots + stride * findKnot(t, r2);
+        const T dz = r2 - knot[0];
+        return knot[1] + dz * (knot[2] + dz * (knot[3] + dz * (knot[4] + dz * (knot[5] + dz * knot[6]))));
+    }
+
+    //! Get tabulated value at df(x)/dx
+    T evalDer(const table &t, T r2) const {
+        const T *knot = values() + t.knots + stride * findKnot(t, r2);
+        const T dz = r2 - knot[0];
+        return knot[2] + dz * (2.0 * knot[3] + dz * (3.0 * knot[4] + dz * (4.0 * knot[5] + dz * (5.0 * knot[6]))));
+    }
+};
+
 #ifdef DOCTEST_LIBRARY_INCLUDED
 TEST_CASE("[Faunus] Andrea") {
     using doctest::Approx;
@@ -335,6 +556,50 @@ TEST_CASE("[Faunus] Andrea") {
     x = 5;
     CHECK(spline.evalDer(d, x) == Approx(f_prime_exact(x)));
 }
+
+TEST_CASE("[Faunus] AndreaLookup") {
+    auto f = [](double x) { return 0.5 * x * std::sin(x) + 2; };
+    Andrea<double> spline;
+    AndreaLookup<double> spline_lookup;
+    spline.setTolerance(2e-6, 1e-4);
+    spline_lookup.setTolerance(2e-6, 1e-4);
+    auto d = spline.generate(f, 0, 10);
+    auto d_lookup = spline_lookup.generate(f, 0, 10);
+    CHECK(!d_lookup.knot_index.empty());
+    CHECK(d_lookup.r2 == d.r2);
+    for (double x : {1e-9, 0.1, 1.0, 2.5, 5.0, 7.7, 9.99, 10.0}) {
+        CHECK(spline_lookup.eval(d_lookup, x) == spline.eval(d, x));
+        CHECK(spline_lookup.evalDer(d_lookup, x) == spline.evalDer(d, x));
+    }
+    for (size_t i = 1; i < d.r2.size(); i++) { // exactly at the knots
+        CHECK(spline_lookup.eval(d_lookup, d.r2[i]) == spline.eval(d, d.r2[i]));
+    }
+}
+TEST_CASE("[Faunus] AndreaArena") {
+    using doctest::Approx;
+    auto f = [](double x) { return 0.5 * x * std::sin(x) + 2; };
+    auto g = [](double x) { return std::exp(-x) / x; };
+    AndreaLookup<double> spline;
+    spline.setTolerance(2e-6, 1e-4);
+    auto d_f = spline.generate(f, 0, 10);
+    auto d_g = spline.generate(g, 0.5, 20, false);
+    AndreaArena<double> arena;
+    auto t_f = arena.add(d_f);
+    auto t_g = arena.add(d_g);
+    CHECK(t_f.num_bins > 0);
+    CHECK(t_g.num_bins == 0);
+    CHECK(t_g.knots % 8 == 0); // starts on a new cache line
+    CHECK(arena.bytes() % 64 == 0);
+    for (double x : {1e-9, 0.1, 1.0, 2.5, 5.0, 7.7, 9.99, 10.0}) {
+        CHECK(arena.eval(t_f, x) == Approx(spline.eval(d_f, x)));
+        CHECK(arena.evalDer(t_f, x) == Approx(spline.evalDer(d_f, x)));
+    }
+    for (double x : {0.6, 1.0, 3.3, 12.0, 19.9}) {
+        CHECK(arena.eval(t_g, x) == Approx(spline.eval(d_g, x)));
+        CHECK(arena.evalDer(t_g, x) == Approx(spline.evalDer(d_g, x)));
+    }
+    CHECK(arena.add(AndreaLookup<double>::data()).empty());
+}
 #endif
 
 } // namespace Tabulate